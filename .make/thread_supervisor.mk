@@ -8,6 +8,11 @@ test: clean
 	${MAKE} spell
 	${MAKE} unit_tests OPTIONS=test
 
+# results are written to ${BUILD_ROOT}/benchmark/benchmark.jsonl
+benchmark:
+	${MAKE} cmake OPTIONS=benchmark
+	${BUILD_ROOT}/benchmark/test/benchmark_supervisor 2> /dev/null | tee ${BUILD_ROOT}/benchmark/benchmark.jsonl
+
 clean: clean_common
 
 dox: doxclean clean
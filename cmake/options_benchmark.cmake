@@ -0,0 +1,2 @@
+set(thread_supervisor_TESTS "ON"        CACHE STRING "")
+set(CMAKE_BUILD_TYPE        "Release"   CACHE STRING "")
@@ -0,0 +1,120 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Per-thread memory resources.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+
+#include "util.h"
+
+
+namespace tut
+{
+    namespace thread
+    {
+        /**
+         * Monotonic arena over a preallocated buffer: allocation is a pointer
+         * bump, deallocation is a no-op, and the whole arena is reset at
+         * once. Allocations exceeding the buffer are served by the upstream
+         * resource and are released on reset. Not thread safe.
+         *
+         * The buffer is allocated without initialization, so its pages are
+         * placed on the NUMA node of the thread that touches them first.
+         */
+        class Arena
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(Arena)
+
+        protected:
+            std::unique_ptr<std::byte[]> buffer_;  // NOLINT
+            std::pmr::monotonic_buffer_resource resource_;
+
+
+        public:
+            /**
+             * @param[in] size buffer size in bytes
+             * @param[in] prefault touch all pages of the buffer immediately
+             */
+            Arena(const std::size_t size, const bool prefault)
+              : buffer_(new std::byte[size])  // NOLINT
+              , resource_(buffer_.get(), size, std::pmr::new_delete_resource())
+            {
+                if (prefault)
+                {
+                    std::memset(buffer_.get(), 0, size);
+                }
+            }
+
+
+            [[nodiscard]] std::pmr::memory_resource *get()
+            {
+                return (&resource_);
+            }
+
+
+            /// Invalidates all allocations, the buffer is reused
+            void reset()
+            {
+                resource_.release();
+            }
+        };
+
+
+
+        /**
+         * Memory resource, which counts bytes that are currently allocated
+         * through it and forwards requests to the upstream resource. The
+         * counter is written by a single thread and can be read by others.
+         */
+        class CountingResource : public std::pmr::memory_resource
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(CountingResource)
+
+        protected:
+            std::pmr::memory_resource *upstream_;
+            std::atomic<std::size_t> *allocated_bytes_;
+
+
+        protected:
+            void *do_allocate(const std::size_t bytes, const std::size_t alignment) override
+            {
+                void *result = upstream_->allocate(bytes, alignment);
+                // single writer
+                allocated_bytes_->store(
+                        allocated_bytes_->load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+                return (result);
+            }
+
+            void do_deallocate(void *pointer, const std::size_t bytes, const std::size_t alignment) override
+            {
+                upstream_->deallocate(pointer, bytes, alignment);
+                const std::size_t allocated_bytes = allocated_bytes_->load(std::memory_order_relaxed);
+                allocated_bytes_->store(
+                        allocated_bytes > bytes ? allocated_bytes - bytes : 0, std::memory_order_relaxed);
+            }
+
+            [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+            {
+                return (this == &other);
+            }
+
+
+        public:
+            CountingResource(std::pmr::memory_resource *upstream, std::atomic<std::size_t> *allocated_bytes)
+              : upstream_(upstream), allocated_bytes_(allocated_bytes)
+            {
+            }
+
+            ~CountingResource() override = default;
+        };
+    }  // namespace thread
+}  // namespace tut
@@ -0,0 +1,202 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Asynchronous logger.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+
+#include "util.h"
+#include "queue.h"
+
+
+namespace tut
+{
+    namespace log
+    {
+        /**
+         * Asynchronous stderr logger: messages are formatted into per-thread
+         * buffers of fixed size (longer messages are truncated) and passed
+         * through a bounded lock-free queue to a background thread. Messages
+         * are dropped when the queue is full, so logging does not wait for the
+         * writer. The background thread sleeps while the queue is empty,
+         * producers take a lock only to wake it up.
+         *
+         * The background thread is owned by the logger rather than by the
+         * supervisor, since it must outlive supervised threads to write their
+         * last messages.
+         */
+        template <std::size_t t_capacity = 1024, std::size_t t_message_size = 256>
+        class Async
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(Async)
+
+        protected:
+            class Message
+            {
+            public:
+                std::array<char, t_message_size> text_;
+                std::size_t length_ = 0;
+            };
+
+
+            /// Formats messages without memory allocation
+            class Buffer : public std::streambuf
+            {
+            public:
+                Message message_;
+                std::ostream stream_;
+
+            public:
+                Buffer() : stream_(this)
+                {
+                    reset();
+                }
+
+                void reset()
+                {
+                    setp(message_.text_.data(), message_.text_.data() + message_.text_.size());
+                    stream_.clear();
+                }
+
+                Message &finalize()
+                {
+                    message_.length_ = static_cast<std::size_t>(pptr() - pbase());
+                    return (message_);
+                }
+            };
+
+
+        protected:
+            mutable thread::MPMCQueue<Message> queue_;
+            mutable std::atomic<std::size_t> dropped_;
+
+            std::atomic<bool> stop_;
+            /// the writer is about to wait or is waiting for messages
+            mutable std::atomic<bool> idle_;
+            mutable std::mutex mutex_;
+            mutable std::condition_variable condition_;
+            std::thread writer_;
+
+
+        protected:
+            static Buffer &getBuffer()
+            {
+                thread_local Buffer buffer;
+                return (buffer);
+            }
+
+
+            void write()
+            {
+                Message message;
+                std::size_t reported_dropped = 0;
+
+                for (;;)
+                {
+                    const bool stop = stop_;
+                    bool written = false;
+
+                    while (queue_.pop(message))
+                    {
+                        std::cerr.write(message.text_.data(), static_cast<std::streamsize>(message.length_)) << '\n';
+                        written = true;
+                    }
+
+                    const std::size_t dropped = dropped_;
+                    if (dropped != reported_dropped)
+                    {
+                        std::cerr << "Logger / dropped messages: " << dropped - reported_dropped << '\n';
+                        reported_dropped = dropped;
+                        written = true;
+                    }
+                    if (written)
+                    {
+                        std::cerr.flush();
+                    }
+
+                    if (stop)
+                    {
+                        break;
+                    }
+
+                    // either the writer sees a message pushed after this point, or the producer sees the flag,
+                    // see notify()
+                    idle_.store(true);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        condition_.wait(lock, [this]() { return (queue_.size() > 0 or stop_.load()); });
+                    }
+                    idle_.store(false, std::memory_order_relaxed);
+                }
+            }
+
+
+            /// Wake up the writer if it is waiting, called after a message is pushed or dropped
+            void notify() const
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (idle_.load(std::memory_order_relaxed))
+                {
+                    const std::lock_guard<std::mutex> lock(mutex_);
+                    condition_.notify_one();
+                }
+            }
+
+
+        public:
+            Async() : queue_(t_capacity)
+            {
+                dropped_ = 0;
+                stop_ = false;
+                idle_ = false;
+                writer_ = std::thread(&Async::write, this);
+            }
+
+
+            ~Async()
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+                }
+                condition_.notify_all();
+                writer_.join();
+            }
+
+
+            template <class... t_Args>
+            void log(const t_Args &...args) const
+            {
+                Buffer &buffer = getBuffer();
+
+                buffer.reset();
+                (buffer.stream_ << ... << args);
+
+                if (not queue_.push(buffer.finalize()))
+                {
+                    ++dropped_;
+                }
+                notify();
+            }
+
+
+            /// Total number of messages dropped due to queue overflow
+            [[nodiscard]] std::size_t getDroppedMessages() const
+            {
+                return (dropped_);
+            }
+        };
+    }  // namespace log
+}  // namespace tut
@@ -0,0 +1,218 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Bounded channels between supervised threads.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "supervisor.h"
+#include "queue.h"
+
+
+namespace tut
+{
+    namespace thread
+    {
+        /**
+         * Bounded lock-free channel with blocking operations, which return
+         * when the supervisor is interrupted or the calling thread is
+         * requested to stop, see Supervisor::isInterrupted(). The channel
+         * must be owned outside of the communicating threads, so that its
+         * contents are preserved when they are restarted.
+         *
+         * Non-blocking operations do not lock, blocking operations wait on a
+         * condition variable when the channel is full or empty, the channel
+         * is notified on interrupts, see Supervisor::subscribe().
+         *
+         * @tparam t_Queue MPMCQueue or SPSCQueue, see also SPSCChannel
+         */
+        template <class t_Item, template <class> class t_Queue = MPMCQueue, class t_Logger = log::StdErr>
+        class Channel : protected InterruptListener
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(Channel)
+
+        protected:
+            t_Queue<t_Item> queue_;
+            const Supervisor<t_Logger> &supervisor_;
+
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<std::size_t> high_water_mark_;
+            std::atomic<std::size_t> push_waiters_;
+            std::atomic<std::size_t> pop_waiters_;
+            std::mutex mutex_;
+            std::condition_variable condition_;
+
+
+        protected:
+            void notify(const std::atomic<std::size_t> &waiters)
+            {
+                // pairs with the fence in @ref wait: either the waiter sees the change, or it is notified
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (waiters.load(std::memory_order_relaxed) > 0)
+                {
+                    const std::lock_guard<std::mutex> lock(mutex_);
+                    condition_.notify_all();
+                }
+            }
+
+
+            template <class t_Predicate>
+            void wait(std::atomic<std::size_t> &waiters, t_Predicate &&predicate)
+            {
+                ++waiters;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    condition_.wait(
+                            lock, [this, &predicate]() { return (predicate() or supervisor_.isInterrupted()); });
+                }
+                --waiters;
+            }
+
+
+            /// Wake up blocked operations, see Supervisor::subscribe()
+            void notifyInterrupt() override
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                condition_.notify_all();
+            }
+
+
+            void updateHighWaterMark()
+            {
+                const std::size_t size = queue_.size();
+                std::size_t high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+                while (size > high_water_mark
+                       and not high_water_mark_.compare_exchange_weak(
+                               high_water_mark, size, std::memory_order_relaxed))
+                {
+                    // retry
+                }
+            }
+
+
+        public:
+            /**
+             * @param[in] supervisor supervisor of communicating threads
+             * @param[in] capacity rounded up to a power of two
+             */
+            Channel(const Supervisor<t_Logger> &supervisor, const std::size_t capacity)
+              : queue_(capacity), supervisor_(supervisor)
+            {
+                high_water_mark_ = 0;
+                push_waiters_ = 0;
+                pop_waiters_ = 0;
+
+                supervisor_.subscribe(*this);
+            }
+
+
+            ~Channel()
+            {
+                supervisor_.unsubscribe(*this);
+            }
+
+
+            [[nodiscard]] std::size_t capacity() const
+            {
+                return (queue_.capacity());
+            }
+
+
+            /// Approximate number of items
+            [[nodiscard]] std::size_t size() const
+            {
+                return (queue_.size());
+            }
+
+
+            /// Maximal observed number of items
+            [[nodiscard]] std::size_t getHighWaterMark() const
+            {
+                return (high_water_mark_.load(std::memory_order_relaxed));
+            }
+
+
+            void resetHighWaterMark()
+            {
+                high_water_mark_.store(0, std::memory_order_relaxed);
+            }
+
+
+            /// Returns false if the channel is full
+            template <class t_Value>
+            bool tryPush(t_Value &&value)
+            {
+                if (queue_.push(std::forward<t_Value>(value)))
+                {
+                    updateHighWaterMark();
+                    notify(pop_waiters_);
+                    return (true);
+                }
+                return (false);
+            }
+
+
+            /// Returns false if the channel is empty
+            bool tryPop(t_Item &item)
+            {
+                if (queue_.pop(item))
+                {
+                    notify(push_waiters_);
+                    return (true);
+                }
+                return (false);
+            }
+
+
+            /// Blocks while the channel is full, returns false if interrupted, the value is not pushed in this case
+            template <class t_Value>
+            bool push(t_Value &&value)
+            {
+                while (not supervisor_.isInterrupted())
+                {
+                    // the value is not moved from if the push fails
+                    if (tryPush(std::forward<t_Value>(value)))
+                    {
+                        return (true);
+                    }
+                    wait(push_waiters_, [this]() { return (queue_.size() < queue_.capacity()); });
+                }
+                return (false);
+            }
+
+
+            /**
+             * Blocks while the channel is empty, returns false if interrupted
+             * and the channel is empty: remaining items can be drained after
+             * interrupt.
+             */
+            bool pop(t_Item &item)
+            {
+                for (;;)
+                {
+                    if (tryPop(item))
+                    {
+                        return (true);
+                    }
+                    if (supervisor_.isInterrupted())
+                    {
+                        return (false);
+                    }
+                    wait(pop_waiters_, [this]() { return (queue_.size() > 0); });
+                }
+            }
+        };
+
+
+        /// Single-producer single-consumer channel
+        template <class t_Item, class t_Logger = log::StdErr>
+        using SPSCChannel = Channel<t_Item, SPSCQueue, t_Logger>;
+    }  // namespace thread
+}  // namespace tut
@@ -0,0 +1,196 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief CPU set helpers, Linux only.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <iterator>
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+
+namespace tut
+{
+    namespace thread
+    {
+        namespace cpu
+        {
+            using Set = std::vector<std::size_t>;
+
+
+            /// Parse CPU list in kernel format, e.g., "0-3,8,10-11", returns sorted set
+            inline Set parseList(const std::string &list)
+            {
+                Set result;
+
+                std::stringstream stream(list);
+                std::string range;
+                while (std::getline(stream, range, ','))
+                {
+                    if (range.empty() or '\n' == range[0])
+                    {
+                        continue;
+                    }
+
+                    const std::size_t dash = range.find('-');
+                    try
+                    {
+                        const std::size_t first = std::stoul(range.substr(0, dash));
+                        const std::size_t last = (std::string::npos == dash) ? first : std::stoul(range.substr(dash + 1));
+
+                        for (std::size_t cpu = first; cpu <= last; ++cpu)
+                        {
+                            result.push_back(cpu);
+                        }
+                    }
+                    catch (const std::exception &)
+                    {
+                        return (Set());
+                    }
+                }
+
+                std::sort(result.begin(), result.end());
+                result.erase(std::unique(result.begin(), result.end()), result.end());
+                return (result);
+            }
+
+
+            /// Read CPU list from a file, returns empty set on failure
+            inline Set readList(const std::string &filename)
+            {
+                std::ifstream file(filename);
+                std::string list;
+                if (file.is_open() and std::getline(file, list))
+                {
+                    return (parseList(list));
+                }
+                return (Set());
+            }
+
+
+            /// Intersection of two sorted sets
+            inline Set intersect(const Set &first, const Set &second)
+            {
+                Set result;
+                std::set_intersection(
+                        first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(result));
+                return (result);
+            }
+
+
+            /// CPUs of the given NUMA node, empty if the node is not found
+            inline Set getNUMANode(const int node)
+            {
+                return (readList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+            }
+
+
+            /// CPUs of the cgroup cpuset controller (v2 or v1), empty if not available
+            inline Set getCgroup()
+            {
+                std::ifstream file("/proc/self/cgroup");
+                std::string line;
+                while (std::getline(file, line))
+                {
+                    // <id>:<controllers>:<path>
+                    const std::size_t first_colon = line.find(':');
+                    const std::size_t second_colon = line.find(':', first_colon + 1);
+                    if (std::string::npos == first_colon or std::string::npos == second_colon)
+                    {
+                        continue;
+                    }
+
+                    const std::string controllers = line.substr(first_colon + 1, second_colon - first_colon - 1);
+                    const std::string path = line.substr(second_colon + 1);
+
+                    Set result;
+                    if (controllers.empty())
+                    {
+                        result = readList("/sys/fs/cgroup" + path + "/cpuset.cpus.effective");
+                    }
+                    else if ("cpuset" == controllers)
+                    {
+                        result = readList("/sys/fs/cgroup/cpuset" + path + "/cpuset.effective_cpus");
+                    }
+
+                    if (not result.empty())
+                    {
+                        return (result);
+                    }
+                }
+                return (Set());
+            }
+
+
+            /**
+             * CPUs available to the process: affinity mask restricted by
+             * cgroup cpuset, detected once. The mask of the main thread is
+             * used, since the caller may be a pinned supervised thread.
+             */
+            inline const Set &getAllowed()
+            {
+                static const Set allowed = []() {
+                    Set result;
+
+                    cpu_set_t cpu_set;
+                    CPU_ZERO(&cpu_set);
+                    // on Linux the process id is the thread id of the main thread, 0 would be the calling thread
+                    if (0 == sched_getaffinity(getpid(), sizeof(cpu_set), &cpu_set))
+                    {
+                        for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                        {
+                            if (CPU_ISSET(cpu, &cpu_set))
+                            {
+                                result.push_back(cpu);
+                            }
+                        }
+                    }
+
+                    const Set cgroup = getCgroup();
+                    if (not cgroup.empty())
+                    {
+                        const Set restricted = intersect(result, cgroup);
+                        if (not restricted.empty())
+                        {
+                            result = restricted;
+                        }
+                    }
+
+                    return (result);
+                }();
+
+                return (allowed);
+            }
+
+
+            /// Pin thread to the given CPUs
+            inline bool setAffinity(const pthread_t handle, const Set &cpus)
+            {
+                cpu_set_t cpu_set;
+                CPU_ZERO(&cpu_set);
+                for (const std::size_t cpu : cpus)
+                {
+                    if (cpu >= CPU_SETSIZE)
+                    {
+                        return (false);
+                    }
+                    CPU_SET(cpu, &cpu_set);
+                }
+
+                return (0 == pthread_setaffinity_np(handle, sizeof(cpu_set), &cpu_set));
+            }
+        }  // namespace cpu
+    }  // namespace thread
+}  // namespace tut
@@ -0,0 +1,341 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Supervised work-stealing executor.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "supervisor.h"
+#include "queue.h"
+
+
+namespace tut
+{
+    namespace thread
+    {
+        /**
+         * Chase-Lev work-stealing deque of fixed capacity: the owner pushes
+         * and pops items at the bottom, other threads steal from the top.
+         * Items must be trivially copyable, e.g., pointers.
+         */
+        template <class t_Item>
+        class WorkStealingDeque
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(WorkStealingDeque)
+
+        protected:
+            const std::int64_t mask_;
+            std::unique_ptr<std::atomic<t_Item>[]> items_;  // NOLINT
+
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<std::int64_t> top_;
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<std::int64_t> bottom_;
+
+
+        public:
+            /// Capacity must be a power of two
+            explicit WorkStealingDeque(const std::size_t capacity)
+              : mask_(static_cast<std::int64_t>(capacity) - 1)
+              , items_(new std::atomic<t_Item>[capacity])  // NOLINT
+            {
+                top_ = 0;
+                bottom_ = 0;
+            }
+
+
+            /// Approximate number of items
+            [[nodiscard]] std::size_t size() const
+            {
+                const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+                const std::int64_t top = top_.load(std::memory_order_relaxed);
+                return (bottom > top ? static_cast<std::size_t>(bottom - top) : 0);
+            }
+
+
+            /// Owner only, returns false if the deque is full
+            bool push(const t_Item item)
+            {
+                const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+                const std::int64_t top = top_.load(std::memory_order_acquire);
+
+                if (bottom - top > mask_)
+                {
+                    return (false);
+                }
+
+                items_[bottom & mask_].store(item, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return (true);
+            }
+
+
+            /// Owner only, returns false if the deque is empty
+            bool pop(t_Item &item)
+            {
+                const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+                bottom_.store(bottom, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                std::int64_t top = top_.load(std::memory_order_relaxed);
+
+                if (top > bottom)
+                {
+                    bottom_.store(bottom + 1, std::memory_order_relaxed);
+                    return (false);
+                }
+
+                item = items_[bottom & mask_].load(std::memory_order_relaxed);
+                if (top == bottom)
+                {
+                    // the last item, race with thieves
+                    const bool success = top_.compare_exchange_strong(
+                            top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                    bottom_.store(bottom + 1, std::memory_order_relaxed);
+                    return (success);
+                }
+                return (true);
+            }
+
+
+            /// Any thread, returns false if the deque is empty or the race is lost
+            bool steal(t_Item &item)
+            {
+                std::int64_t top = top_.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+                if (top < bottom)
+                {
+                    item = items_[top & mask_].load(std::memory_order_relaxed);
+                    return (top_.compare_exchange_strong(
+                            top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed));
+                }
+                return (false);
+            }
+        };
+
+
+
+        /**
+         * Executes tasks on a fixed number of supervised worker threads. Each
+         * worker has its own work-stealing deque, tasks submitted by workers
+         * go to their deques, other tasks and overflow go to a shared
+         * injection queue. Idle workers steal tasks from others.
+         *
+         * Queues are owned by the executor, so when a task throws and the
+         * worker is restarted according to Parameters::Restart, the tasks
+         * queued in its deque are preserved. The failed task is discarded.
+         */
+        template <class t_Logger = log::StdErr>
+        class Executor : protected InterruptListener
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(Executor)
+
+        public:
+            using Task = std::function<void()>;
+
+
+        protected:
+            class alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) Worker
+            {
+            public:
+                const Executor *owner_;
+                WorkStealingDeque<Task *> deque_;
+
+            public:
+                Worker(const Executor *owner, const std::size_t capacity) : owner_(owner), deque_(capacity)
+                {
+                }
+            };
+
+
+        protected:
+            std::vector<std::unique_ptr<Worker>> workers_;
+            MPMCQueue<Task *> injection_queue_;
+
+            std::atomic<std::size_t> idle_workers_;
+            std::mutex idle_mutex_;
+            std::condition_variable idle_condition_;
+
+            Supervisor<t_Logger> supervisor_;
+
+
+        protected:
+            static Worker *&getCurrentWorker()
+            {
+                thread_local Worker *worker = nullptr;
+                return (worker);
+            }
+
+
+            bool steal(const std::size_t thief, Task *&task)
+            {
+                for (std::size_t i = 1; i < workers_.size(); ++i)
+                {
+                    if (workers_[(thief + i) % workers_.size()]->deque_.steal(task))
+                    {
+                        return (true);
+                    }
+                }
+                return (false);
+            }
+
+
+            [[nodiscard]] bool hasTasks() const
+            {
+                if (injection_queue_.size() > 0)
+                {
+                    return (true);
+                }
+                for (const std::unique_ptr<Worker> &worker : workers_)
+                {
+                    if (worker->deque_.size() > 0)
+                    {
+                        return (true);
+                    }
+                }
+                return (false);
+            }
+
+
+            void work(const std::size_t index)
+            {
+                Worker &worker = *workers_[index];
+                getCurrentWorker() = &worker;
+
+                while (not supervisor_.isInterrupted())
+                {
+                    Task *task = nullptr;
+                    if (worker.deque_.pop(task) or injection_queue_.pop(task) or steal(index, task))
+                    {
+                        // the task is discarded even if it throws
+                        const std::unique_ptr<Task> task_guard(task);
+                        (*task)();
+                    }
+                    else
+                    {
+                        // pairs with the fence in @ref submit: either the worker sees the task, or the
+                        // producer sees the idle worker and notifies it under the lock
+                        ++idle_workers_;
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                        {
+                            std::unique_lock<std::mutex> lock(idle_mutex_);
+                            idle_condition_.wait(
+                                    lock, [this]() { return (hasTasks() or supervisor_.isInterrupted()); });
+                        }
+                        --idle_workers_;
+                    }
+                }
+            }
+
+
+            /// Wake up idle workers, see Supervisor::subscribe()
+            void notifyInterrupt() override
+            {
+                const std::lock_guard<std::mutex> lock(idle_mutex_);
+                idle_condition_.notify_all();
+            }
+
+
+        public:
+            /**
+             * @param[in] workers_number number of worker threads
+             * @param[in] parameters parameters of worker threads
+             * @param[in] queue_capacity capacity of each queue, rounded up to a power of two
+             */
+            explicit Executor(
+                    const std::size_t workers_number,
+                    const Parameters &parameters = Parameters(),
+                    const std::size_t queue_capacity = 4096)
+              : injection_queue_(queue_capacity)
+            {
+                idle_workers_ = 0;
+
+                const std::size_t capacity = injection_queue_.capacity();
+                workers_.reserve(workers_number);
+                for (std::size_t i = 0; i < workers_number; ++i)
+                {
+                    workers_.push_back(std::make_unique<Worker>(this, capacity));
+                }
+
+                supervisor_.subscribe(*this);
+
+                for (std::size_t i = 0; i < workers_number; ++i)
+                {
+                    supervisor_.add(Parameters(parameters), &Executor::work, this, i);
+                }
+            }
+
+
+            ~Executor()
+            {
+                stop();
+                supervisor_.unsubscribe(*this);
+
+                Task *task = nullptr;
+                while (injection_queue_.pop(task))
+                {
+                    delete task;  // NOLINT
+                }
+                for (const std::unique_ptr<Worker> &worker : workers_)
+                {
+                    while (worker->deque_.pop(task))
+                    {
+                        delete task;  // NOLINT
+                    }
+                }
+            }
+
+
+            /// Stop workers, pending tasks are not executed
+            bool stop(const std::size_t wait_ms = 10000)
+            {
+                return (supervisor_.stop(wait_ms));
+            }
+
+
+            [[nodiscard]] Supervisor<t_Logger> &getSupervisor()
+            {
+                return (supervisor_);
+            }
+
+
+            /// Returns false if queues are full or the executor is stopped
+            bool submit(Task task)
+            {
+                if (supervisor_.isInterrupted())
+                {
+                    return (false);
+                }
+
+                std::unique_ptr<Task> new_task = std::make_unique<Task>(std::move(task));
+
+                Worker *worker = getCurrentWorker();
+                if ((nullptr == worker or this != worker->owner_ or not worker->deque_.push(new_task.get()))
+                    and not injection_queue_.push(new_task.get()))
+                {
+                    return (false);
+                }
+                new_task.release();  // NOLINT owned by a queue
+
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (idle_workers_.load(std::memory_order_relaxed) > 0)
+                {
+                    const std::lock_guard<std::mutex> lock(idle_mutex_);
+                    idle_condition_.notify_one();
+                }
+                return (true);
+            }
+        };
+    }  // namespace thread
+}  // namespace tut
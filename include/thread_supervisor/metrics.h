@@ -0,0 +1,329 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Thread runtime metrics and crash reports.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+#include <cxxabi.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>  // NOLINT
+#include <unistd.h>
+
+#include "registry.h"
+
+
+namespace tut
+{
+    namespace thread
+    {
+        /// Snapshot of thread runtime metrics
+        class Metrics
+        {
+        public:
+            enum class ExitReason
+            {
+                NONE = 0,       /// thread function has not returned yet
+                RETURN = 1,     /// thread function returned
+                EXCEPTION = 2,  /// thread function has thrown an exception
+            };
+
+
+        public:
+            RegistryHandle reference_;
+            bool running_ = false;  /// false if the thread is terminated but not joined yet
+            std::int64_t tid_ = 0;  /// OS thread id, 0 if the thread has not started yet
+            std::string name_;      /// OS thread name, empty if not set, see Parameters::Name
+            /// bytes allocated via Supervisor::getMemoryResource(), tracked only with Parameters::Budget
+            std::size_t allocated_bytes_ = 0;
+
+            std::size_t restarts_ = 0;
+            std::size_t exceptions_ = 0;
+            ExitReason last_exit_reason_ = ExitReason::NONE;
+            std::string last_exception_type_;  /// demangled type name, empty if there were no exceptions
+
+            std::chrono::nanoseconds wall_time_ = std::chrono::nanoseconds(0);
+            std::chrono::nanoseconds cpu_time_ = std::chrono::nanoseconds(0);
+            std::chrono::nanoseconds backoff_time_ = std::chrono::nanoseconds(0);
+            std::chrono::steady_clock::time_point last_start_time_;
+
+            /// periodic threads only, see Parameters::Period
+            std::size_t periods_ = 0;
+            std::size_t missed_deadlines_ = 0;
+            std::chrono::nanoseconds max_jitter_ = std::chrono::nanoseconds(0);   /// maximal wake up delay
+            std::chrono::nanoseconds mean_jitter_ = std::chrono::nanoseconds(0);  /// mean wake up delay
+        };
+
+
+        /// Thread runtime counters, updated by the thread without locking
+        class MetricsCounters
+        {
+        protected:
+            std::atomic<std::int64_t> tid_;
+            std::atomic<std::size_t> restarts_;
+            std::atomic<std::size_t> exceptions_;
+            std::atomic<Metrics::ExitReason> last_exit_reason_;
+            std::atomic<const std::type_info *> last_exception_type_;
+
+            std::atomic<std::int64_t> start_time_ns_;
+            std::atomic<std::int64_t> stop_time_ns_;
+            std::atomic<std::int64_t> last_start_time_ns_;
+            std::atomic<std::int64_t> backoff_time_ns_;
+
+            std::atomic<std::size_t> periods_;
+            std::atomic<std::size_t> missed_deadlines_;
+            std::atomic<std::int64_t> max_jitter_ns_;
+            std::atomic<std::int64_t> total_jitter_ns_;
+
+            std::atomic<bool> cpu_clock_valid_;
+            std::atomic<clockid_t> cpu_clock_;
+            std::atomic<std::int64_t> cpu_time_ns_;
+
+
+        protected:
+            static std::int64_t now()
+            {
+                return (std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+            }
+
+            static std::int64_t getCPUTime(const clockid_t clock)
+            {
+                timespec time;
+                if (0 == clock_gettime(clock, &time))
+                {
+                    return (static_cast<std::int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec);
+                }
+                return (-1);
+            }
+
+        public:
+            /// Demangled type name, empty if type is null
+            static std::string demangle(const std::type_info *type)
+            {
+                if (nullptr == type)
+                {
+                    return ("");
+                }
+
+                int status = 0;
+                const std::unique_ptr<char, decltype(&std::free)> name(
+                        abi::__cxa_demangle(type->name(), nullptr, nullptr, &status), &std::free);
+                return ((0 == status and nullptr != name) ? std::string(name.get()) : std::string(type->name()));
+            }
+
+
+            MetricsCounters()
+            {
+                reset();
+            }
+
+
+            /// Called before the thread is created
+            void reset()
+            {
+                tid_ = 0;
+                restarts_ = 0;
+                exceptions_ = 0;
+                last_exit_reason_ = Metrics::ExitReason::NONE;
+                last_exception_type_ = nullptr;
+
+                start_time_ns_ = now();
+                stop_time_ns_ = 0;
+                last_start_time_ns_ = 0;
+                backoff_time_ns_ = 0;
+
+                periods_ = 0;
+                missed_deadlines_ = 0;
+                max_jitter_ns_ = 0;
+                total_jitter_ns_ = 0;
+
+                cpu_clock_valid_ = false;
+                cpu_time_ns_ = 0;
+            }
+
+
+            /// Called by the thread when it is started
+            void startThread()
+            {
+                tid_.store(static_cast<std::int64_t>(syscall(SYS_gettid)), std::memory_order_relaxed);
+
+                clockid_t clock;
+                if (0 == pthread_getcpuclockid(pthread_self(), &clock))
+                {
+                    cpu_clock_.store(clock, std::memory_order_relaxed);
+                    cpu_clock_valid_.store(true, std::memory_order_release);
+                }
+            }
+
+            /// Called by the thread before termination
+            void stopThread()
+            {
+                if (cpu_clock_valid_.load(std::memory_order_relaxed))
+                {
+                    cpu_time_ns_.store(
+                            std::max<std::int64_t>(0, getCPUTime(cpu_clock_.load(std::memory_order_relaxed))),
+                            std::memory_order_relaxed);
+                    cpu_clock_valid_.store(false, std::memory_order_release);
+                }
+                stop_time_ns_.store(now(), std::memory_order_release);
+            }
+
+            /// CPU time consumed by the thread, -1 if the thread is not running
+            [[nodiscard]] std::int64_t getCurrentCPUTime() const
+            {
+                if (cpu_clock_valid_.load(std::memory_order_acquire))
+                {
+                    return (getCPUTime(cpu_clock_.load(std::memory_order_relaxed)));
+                }
+                return (-1);
+            }
+
+            /// OS thread id, 0 if the thread has not started yet
+            [[nodiscard]] std::int64_t getTid() const
+            {
+                return (tid_.load(std::memory_order_relaxed));
+            }
+
+            void startAttempt(const std::size_t attempt)
+            {
+                restarts_.store(attempt, std::memory_order_relaxed);
+                last_start_time_ns_.store(now(), std::memory_order_relaxed);
+            }
+
+            void stopAttempt()
+            {
+                last_exit_reason_.store(Metrics::ExitReason::RETURN, std::memory_order_relaxed);
+            }
+
+            void stopAttempt(const std::type_info &exception_type)
+            {
+                exceptions_.fetch_add(1, std::memory_order_relaxed);
+                last_exception_type_.store(&exception_type, std::memory_order_relaxed);
+                last_exit_reason_.store(Metrics::ExitReason::EXCEPTION, std::memory_order_relaxed);
+            }
+
+            void addBackoffTime(const std::chrono::steady_clock::duration &duration)
+            {
+                backoff_time_ns_.fetch_add(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+                        std::memory_order_relaxed);
+            }
+
+            /// Wake up delay relative to the deadline
+            void addPeriod(const std::chrono::steady_clock::duration &jitter)
+            {
+                const std::int64_t jitter_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(jitter).count();
+
+                // single writer
+                periods_.store(periods_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                total_jitter_ns_.store(
+                        total_jitter_ns_.load(std::memory_order_relaxed) + jitter_ns, std::memory_order_relaxed);
+                if (jitter_ns > max_jitter_ns_.load(std::memory_order_relaxed))
+                {
+                    max_jitter_ns_.store(jitter_ns, std::memory_order_relaxed);
+                }
+            }
+
+            void addMissedDeadlines(const std::size_t missed)
+            {
+                missed_deadlines_.fetch_add(missed, std::memory_order_relaxed);
+            }
+
+
+            [[nodiscard]] Metrics get(const RegistryHandle &reference) const
+            {
+                Metrics metrics;
+
+                metrics.reference_ = reference;
+                metrics.tid_ = tid_.load(std::memory_order_relaxed);
+                metrics.restarts_ = restarts_.load(std::memory_order_relaxed);
+                metrics.exceptions_ = exceptions_.load(std::memory_order_relaxed);
+                metrics.last_exit_reason_ = last_exit_reason_.load(std::memory_order_relaxed);
+                metrics.last_exception_type_ = demangle(last_exception_type_.load(std::memory_order_relaxed));
+                metrics.backoff_time_ = std::chrono::nanoseconds(backoff_time_ns_.load(std::memory_order_relaxed));
+                metrics.last_start_time_ = std::chrono::steady_clock::time_point(std::chrono::duration_cast<
+                                                                                 std::chrono::steady_clock::duration>(
+                        std::chrono::nanoseconds(last_start_time_ns_.load(std::memory_order_relaxed))));
+
+                metrics.periods_ = periods_.load(std::memory_order_relaxed);
+                metrics.missed_deadlines_ = missed_deadlines_.load(std::memory_order_relaxed);
+                metrics.max_jitter_ = std::chrono::nanoseconds(max_jitter_ns_.load(std::memory_order_relaxed));
+                if (metrics.periods_ > 0)
+                {
+                    metrics.mean_jitter_ = std::chrono::nanoseconds(
+                            total_jitter_ns_.load(std::memory_order_relaxed)
+                            / static_cast<std::int64_t>(metrics.periods_));
+                }
+
+                const std::int64_t stop_time_ns = stop_time_ns_.load(std::memory_order_acquire);
+                metrics.running_ = (0 == stop_time_ns);
+                metrics.wall_time_ = std::chrono::nanoseconds(
+                        (metrics.running_ ? now() : stop_time_ns) - start_time_ns_.load(std::memory_order_relaxed));
+
+                // the clock becomes invalid when the thread exits
+                const std::int64_t cpu_time_ns = cpu_clock_valid_.load(std::memory_order_acquire)
+                                                         ? getCPUTime(cpu_clock_.load(std::memory_order_relaxed))
+                                                         : -1;
+                metrics.cpu_time_ = std::chrono::nanoseconds(
+                        cpu_time_ns >= 0 ? cpu_time_ns : cpu_time_ns_.load(std::memory_order_acquire));
+
+                return (metrics);
+            }
+        };
+
+
+        /// Last exception intercepted in a thread, see Parameters::ExceptionHandler
+        class CrashReport
+        {
+        public:
+            RegistryHandle reference_;
+            std::exception_ptr exception_;          /// null if the thread has not crashed
+            const std::type_info *type_ = nullptr;  /// type of the exception, can be of any type
+            std::chrono::system_clock::time_point time_;
+            std::size_t attempt_ = 0;  /// attempt number starting from 0, see Parameters::Restart
+
+        public:
+            /// Demangled lazily, the crashing thread only records type_
+            [[nodiscard]] std::string getTypeName() const
+            {
+                return (MetricsCounters::demangle(type_));
+            }
+
+            /// std::exception::what(), empty for other types
+            [[nodiscard]] std::string getMessage() const
+            {
+                if (nullptr != exception_)
+                {
+                    try
+                    {
+                        std::rethrow_exception(exception_);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        return (e.what());
+                    }
+                    catch (...)
+                    {
+                    }
+                }
+                return (std::string());
+            }
+        };
+    }  // namespace thread
+}  // namespace tut
@@ -0,0 +1,256 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Lock-free bounded queues.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+#include "util.h"
+
+
+namespace tut
+{
+    namespace thread
+    {
+        /**
+         * Bounded multi-producer multi-consumer lock-free queue (D. Vyukov's
+         * algorithm), memory is allocated once in the constructor.
+         */
+        template <class t_Item>
+        class MPMCQueue
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(MPMCQueue)
+
+        protected:
+            class alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) Cell
+            {
+            public:
+                std::atomic<std::size_t> sequence_;
+                t_Item item_;
+            };
+
+
+        protected:
+            const std::size_t mask_;
+            std::unique_ptr<Cell[]> cells_;  // NOLINT
+
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<std::size_t> push_position_;
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<std::size_t> pop_position_;
+
+
+        public:
+            /// Smallest power of two not less than the given capacity
+            static std::size_t roundCapacity(const std::size_t capacity)
+            {
+                std::size_t result = 2;
+                while (result < capacity)
+                {
+                    result *= 2;
+                }
+                return (result);
+            }
+
+
+        public:
+            /// Capacity is rounded up to a power of two
+            explicit MPMCQueue(const std::size_t capacity)
+              : mask_(roundCapacity(capacity) - 1), cells_(new Cell[mask_ + 1])  // NOLINT
+            {
+                for (std::size_t i = 0; i <= mask_; ++i)
+                {
+                    cells_[i].sequence_.store(i, std::memory_order_relaxed);
+                }
+                push_position_.store(0, std::memory_order_relaxed);
+                pop_position_.store(0, std::memory_order_relaxed);
+            }
+
+
+            [[nodiscard]] std::size_t capacity() const
+            {
+                return (mask_ + 1);
+            }
+
+
+            /// Approximate number of items, positions are read separately
+            [[nodiscard]] std::size_t size() const
+            {
+                const std::size_t pop_position = pop_position_.load(std::memory_order_relaxed);
+                const std::size_t push_position = push_position_.load(std::memory_order_relaxed);
+                return (push_position > pop_position ? std::min(push_position - pop_position, capacity()) : 0);
+            }
+
+
+            /// Returns false if the queue is full
+            template <class t_Value>
+            bool push(t_Value &&value)
+            {
+                Cell *cell = nullptr;
+                std::size_t position = push_position_.load(std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    cell = &cells_[position & mask_];
+                    const std::size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+                    const std::ptrdiff_t difference =
+                            static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                    if (0 == difference)
+                    {
+                        if (push_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (difference < 0)
+                        {
+                            return (false);
+                        }
+                        position = push_position_.load(std::memory_order_relaxed);
+                    }
+                }
+
+                cell->item_ = std::forward<t_Value>(value);
+                cell->sequence_.store(position + 1, std::memory_order_release);
+                return (true);
+            }
+
+
+            /// Returns false if the queue is empty
+            bool pop(t_Item &item)
+            {
+                Cell *cell = nullptr;
+                std::size_t position = pop_position_.load(std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    cell = &cells_[position & mask_];
+                    const std::size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+                    const std::ptrdiff_t difference =
+                            static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+                    if (0 == difference)
+                    {
+                        if (pop_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (difference < 0)
+                        {
+                            return (false);
+                        }
+                        position = pop_position_.load(std::memory_order_relaxed);
+                    }
+                }
+
+                item = std::move(cell->item_);
+                cell->sequence_.store(position + mask_ + 1, std::memory_order_release);
+                return (true);
+            }
+        };
+
+
+
+        /**
+         * Bounded single-producer single-consumer lock-free ring buffer,
+         * cheaper than MPMCQueue: each side caches the position of the other
+         * side and reads it only when the ring looks full or empty.
+         */
+        template <class t_Item>
+        class SPSCQueue
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(SPSCQueue)
+
+        protected:
+            const std::size_t mask_;
+            std::unique_ptr<t_Item[]> items_;  // NOLINT
+
+            /// producer side
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<std::size_t> push_position_;
+            std::size_t cached_pop_position_;
+
+            /// consumer side
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<std::size_t> pop_position_;
+            std::size_t cached_push_position_;
+
+
+        public:
+            /// Capacity is rounded up to a power of two
+            explicit SPSCQueue(const std::size_t capacity)
+              : mask_(MPMCQueue<t_Item>::roundCapacity(capacity) - 1), items_(new t_Item[mask_ + 1])  // NOLINT
+            {
+                push_position_.store(0, std::memory_order_relaxed);
+                pop_position_.store(0, std::memory_order_relaxed);
+                cached_pop_position_ = 0;
+                cached_push_position_ = 0;
+            }
+
+
+            [[nodiscard]] std::size_t capacity() const
+            {
+                return (mask_ + 1);
+            }
+
+
+            /// Approximate number of items, positions are read separately
+            [[nodiscard]] std::size_t size() const
+            {
+                const std::size_t pop_position = pop_position_.load(std::memory_order_relaxed);
+                const std::size_t push_position = push_position_.load(std::memory_order_relaxed);
+                return (push_position > pop_position ? std::min(push_position - pop_position, capacity()) : 0);
+            }
+
+
+            /// Producer only, returns false if the queue is full
+            template <class t_Value>
+            bool push(t_Value &&value)
+            {
+                const std::size_t position = push_position_.load(std::memory_order_relaxed);
+                if (position - cached_pop_position_ > mask_)
+                {
+                    cached_pop_position_ = pop_position_.load(std::memory_order_acquire);
+                    if (position - cached_pop_position_ > mask_)
+                    {
+                        return (false);
+                    }
+                }
+
+                items_[position & mask_] = std::forward<t_Value>(value);
+                push_position_.store(position + 1, std::memory_order_release);
+                return (true);
+            }
+
+
+            /// Consumer only, returns false if the queue is empty
+            bool pop(t_Item &item)
+            {
+                const std::size_t position = pop_position_.load(std::memory_order_relaxed);
+                if (position == cached_push_position_)
+                {
+                    cached_push_position_ = push_position_.load(std::memory_order_acquire);
+                    if (position == cached_push_position_)
+                    {
+                        return (false);
+                    }
+                }
+
+                item = std::move(items_[position & mask_]);
+                pop_position_.store(position + 1, std::memory_order_release);
+                return (true);
+            }
+        };
+    }  // namespace thread
+}  // namespace tut
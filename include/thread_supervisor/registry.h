@@ -0,0 +1,443 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Slab registry with generation-indexed handles.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "util.h"
+
+
+namespace tut
+{
+    namespace thread
+    {
+        /// Stable reference to a registry item, becomes stale when the item is released
+        class RegistryHandle
+        {
+        public:
+            static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+        public:
+            std::uint32_t index_ = INVALID_INDEX;
+            std::uint32_t generation_ = 0;
+
+        public:
+            [[nodiscard]] bool isValid() const
+            {
+                return (INVALID_INDEX != index_);
+            }
+
+            [[nodiscard]] bool operator==(const RegistryHandle &other) const
+            {
+                return (index_ == other.index_ and generation_ == other.generation_);
+            }
+
+            [[nodiscard]] bool operator!=(const RegistryHandle &other) const
+            {
+                return (not(*this == other));
+            }
+        };
+
+
+        /**
+         * Registry of items stored in preallocated chunks, which are never
+         * freed or moved. Acquisition and release of items use a lock-free
+         * free list, termination of items is published via a lock-free
+         * intrusive stack, which is emptied by @ref reap. Memory is allocated
+         * only when all existing slots are occupied.
+         *
+         * Acquired items are visible to @ref find and @ref forEach only
+         * after @ref publish, so that they can be initialized first. Both
+         * pin the slot while the item is used, @ref reap waits for readers
+         * to unpin it before the slot is released and can be reused.
+         */
+        template <class t_Item, std::size_t t_chunk_size = 64, std::size_t t_max_chunks = 1024>
+        class Registry
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(Registry)
+
+        public:
+            using Handle = RegistryHandle;
+
+
+        protected:
+            class alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) Slot
+            {
+            public:
+                t_Item item_;
+
+                std::uint32_t index_ = 0;
+                std::atomic<std::uint32_t> generation_;
+                std::atomic<bool> active_;
+
+                /// index + 1 of the next free slot, 0 = none
+                std::atomic<std::uint32_t> next_free_;
+                Slot *next_terminated_ = nullptr;
+
+                /// number of readers using the item, see @ref pin
+                std::atomic<std::size_t> pins_;
+            };
+
+
+        public:
+            /// Pinned item returned by @ref find, the slot is not released while the guard exists
+            class Guard
+            {
+            protected:
+                Slot *slot_ = nullptr;
+
+            public:
+                Guard() = default;
+
+                explicit Guard(Slot *slot) : slot_(slot)
+                {
+                }
+
+                Guard(const Guard &) = delete;
+                Guard &operator=(const Guard &) = delete;
+
+                Guard(Guard &&other) noexcept : slot_(other.slot_)
+                {
+                    other.slot_ = nullptr;
+                }
+
+                Guard &operator=(Guard &&other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        reset();
+                        slot_ = other.slot_;
+                        other.slot_ = nullptr;
+                    }
+                    return (*this);
+                }
+
+                ~Guard()
+                {
+                    reset();
+                }
+
+                void reset()
+                {
+                    if (nullptr != slot_)
+                    {
+                        unpin(*slot_);
+                        slot_ = nullptr;
+                    }
+                }
+
+                /// nullptr if the handle is stale
+                [[nodiscard]] t_Item *get() const
+                {
+                    return (nullptr == slot_ ? nullptr : &slot_->item_);
+                }
+
+                t_Item *operator->() const
+                {
+                    return (get());
+                }
+
+                t_Item &operator*() const
+                {
+                    return (*get());
+                }
+
+                explicit operator bool() const
+                {
+                    return (nullptr != slot_);
+                }
+            };
+
+
+        protected:
+            std::array<std::unique_ptr<Slot[]>, t_max_chunks> chunks_;  // NOLINT
+            std::atomic<std::size_t> chunks_number_;
+            std::mutex growth_mutex_;
+
+            /// (ABA tag << 32) | (index + 1) of the top free slot
+            std::atomic<std::uint64_t> free_head_;
+            std::atomic<Slot *> terminated_head_;
+            std::atomic<std::size_t> size_;
+
+
+        protected:
+            Slot &getSlot(const std::uint32_t index) const
+            {
+                return (chunks_[index / t_chunk_size][index % t_chunk_size]);
+            }
+
+
+            /**
+             * Returns false if the slot is not active, the slot must be
+             * unpinned in both cases. seq_cst: @ref reap deactivates the
+             * slot before checking pins, so either it sees the pin, or the
+             * reader sees the deactivation.
+             */
+            static bool pin(Slot &slot)
+            {
+                slot.pins_.fetch_add(1, std::memory_order_seq_cst);
+                return (slot.active_.load(std::memory_order_seq_cst));
+            }
+
+
+            static void unpin(Slot &slot)
+            {
+                slot.pins_.fetch_sub(1, std::memory_order_release);
+            }
+
+
+            void pushFree(Slot &slot)
+            {
+                std::uint64_t head = free_head_.load(std::memory_order_relaxed);
+                std::uint64_t new_head = 0;
+                do
+                {
+                    slot.next_free_.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+                    new_head = (((head >> 32U) + 1U) << 32U) | (slot.index_ + 1U);
+                } while (not free_head_.compare_exchange_weak(
+                        head, new_head, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+
+            Slot *popFree()
+            {
+                std::uint64_t head = free_head_.load(std::memory_order_acquire);
+                for (;;)
+                {
+                    const std::uint32_t top = static_cast<std::uint32_t>(head);
+                    if (0 == top)
+                    {
+                        return (nullptr);
+                    }
+
+                    Slot &slot = getSlot(top - 1);
+                    const std::uint64_t new_head =
+                            (((head >> 32U) + 1U) << 32U) | slot.next_free_.load(std::memory_order_relaxed);
+                    if (free_head_.compare_exchange_weak(
+                                head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+                    {
+                        return (&slot);
+                    }
+                }
+            }
+
+
+            Slot *grow()
+            {
+                const std::lock_guard<std::mutex> lock(growth_mutex_);
+
+                // another thread may have added a chunk while we were waiting
+                Slot *slot = popFree();
+                if (nullptr != slot)
+                {
+                    return (slot);
+                }
+
+                const std::size_t chunk_index = chunks_number_.load(std::memory_order_relaxed);
+                if (chunk_index >= t_max_chunks)
+                {
+                    return (nullptr);
+                }
+
+                chunks_[chunk_index].reset(new Slot[t_chunk_size]);  // NOLINT
+                for (std::size_t i = 0; i < t_chunk_size; ++i)
+                {
+                    Slot &new_slot = chunks_[chunk_index][i];
+                    new_slot.index_ = static_cast<std::uint32_t>(chunk_index * t_chunk_size + i);
+                    new_slot.generation_.store(0, std::memory_order_relaxed);
+                    new_slot.active_.store(false, std::memory_order_relaxed);
+                    new_slot.next_free_.store(0, std::memory_order_relaxed);
+                    new_slot.pins_.store(0, std::memory_order_relaxed);
+                }
+                chunks_number_.store(chunk_index + 1, std::memory_order_release);
+
+                // the first slot of the chunk is returned, the rest are made available to others
+                for (std::size_t i = t_chunk_size - 1; i > 0; --i)
+                {
+                    pushFree(chunks_[chunk_index][i]);
+                }
+                return (&chunks_[chunk_index][0]);
+            }
+
+
+        public:
+            /// The first chunk is preallocated
+            Registry()
+            {
+                chunks_number_ = 0;
+                free_head_ = 0;
+                terminated_head_ = nullptr;
+                size_ = 0;
+
+                pushFree(*grow());
+            }
+
+
+            /// Number of acquired items
+            [[nodiscard]] std::size_t size() const
+            {
+                return (size_.load(std::memory_order_acquire));
+            }
+
+
+            [[nodiscard]] bool empty() const
+            {
+                return (0 == size());
+            }
+
+
+            /// Returns invalid handle if the maximal number of items is reached, the item must be published
+            Handle acquire()
+            {
+                Slot *slot = popFree();
+                if (nullptr == slot)
+                {
+                    slot = grow();
+                    if (nullptr == slot)
+                    {
+                        return (Handle());
+                    }
+                }
+
+                Handle handle;
+                handle.index_ = slot->index_;
+                handle.generation_ = slot->generation_.load(std::memory_order_relaxed) + 1;
+
+                slot->generation_.store(handle.generation_, std::memory_order_relaxed);
+                size_.fetch_add(1, std::memory_order_acq_rel);
+
+                return (handle);
+            }
+
+
+            /// Make an initialized item visible to other threads, see @ref acquire
+            void publish(const Handle &handle)
+            {
+                getSlot(handle.index_).active_.store(true, std::memory_order_release);
+            }
+
+
+            /// Handle must be valid
+            t_Item &get(const Handle &handle)
+            {
+                return (getSlot(handle.index_).item_);
+            }
+
+
+            /// Returns an empty guard if the handle is stale, the guard must not outlive the registry
+            Guard find(const Handle &handle)
+            {
+                if (not handle.isValid()
+                    or handle.index_ >= chunks_number_.load(std::memory_order_acquire) * t_chunk_size)
+                {
+                    return (Guard());
+                }
+
+                Slot &slot = getSlot(handle.index_);
+                if (pin(slot) and slot.generation_.load(std::memory_order_relaxed) == handle.generation_)
+                {
+                    return (Guard(&slot));
+                }
+                unpin(slot);
+                return (Guard());
+            }
+
+
+            /// Publish termination of an item, see @ref reap
+            void terminate(const Handle &handle)
+            {
+                Slot &slot = getSlot(handle.index_);
+
+                // seq_cst: waiters register before checking @ref hasTerminated, and the terminating thread checks
+                // for waiters after this, so one of them must observe the other
+                Slot *head = terminated_head_.load(std::memory_order_relaxed);
+                do
+                {
+                    slot.next_terminated_ = head;
+                } while (not terminated_head_.compare_exchange_weak(
+                        head, &slot, std::memory_order_seq_cst, std::memory_order_relaxed));
+            }
+
+
+            [[nodiscard]] bool hasTerminated() const
+            {
+                return (nullptr != terminated_head_.load(std::memory_order_seq_cst));
+            }
+
+
+            /**
+             * Call the given function for all terminated items and release
+             * them, returns number of released items. Waits until the items
+             * are not used by @ref find and @ref forEach, must not be called
+             * while holding a guard.
+             */
+            template <class t_Function>
+            std::size_t reap(t_Function &&function)
+            {
+                std::size_t counter = 0;
+                Slot *slot = terminated_head_.exchange(nullptr, std::memory_order_acquire);
+
+                while (nullptr != slot)
+                {
+                    Slot *next = slot->next_terminated_;
+
+                    // see @ref pin, readers are short and never reap
+                    slot->active_.store(false, std::memory_order_seq_cst);
+                    while (0 != slot->pins_.load(std::memory_order_seq_cst))
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    function(slot->item_);
+                    pushFree(*slot);
+                    size_.fetch_sub(1, std::memory_order_acq_rel);
+                    ++counter;
+
+                    slot = next;
+                }
+
+                return (counter);
+            }
+
+
+            /// Call the given function for all published items: (<handle>, <item>), items are pinned during the call
+            template <class t_Function>
+            void forEach(t_Function &&function)
+            {
+                const std::size_t chunks_number = chunks_number_.load(std::memory_order_acquire);
+                for (std::size_t i = 0; i < chunks_number; ++i)
+                {
+                    for (std::size_t j = 0; j < t_chunk_size; ++j)
+                    {
+                        Slot &slot = chunks_[i][j];
+                        if (pin(slot))
+                        {
+                            const Guard guard(&slot);
+
+                            Handle handle;
+                            handle.index_ = slot.index_;
+                            handle.generation_ = slot.generation_.load(std::memory_order_relaxed);
+                            function(handle, slot.item_);
+                        }
+                        else
+                        {
+                            unpin(slot);
+                        }
+                    }
+                }
+            }
+        };
+    }  // namespace thread
+}  // namespace tut
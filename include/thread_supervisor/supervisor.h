@@ -10,16 +10,46 @@
 #pragma once
 
 #include <thread>
+#include <tuple>
+#include <cstdint>
+#include <type_traits>
 #include <functional>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <future>
 #include <iostream>
 #include <chrono>
-#include <list>
-
+#include <vector>
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <cxxabi.h>
 #include <pthread.h>
 
 #include "util.h"
+#include "arena.h"
+#include "cpu.h"
+#include "registry.h"
+#include "metrics.h"
+#include "queue.h"
+#include "timer_wheel.h"
+
+
+#ifndef THREAD_SUPERVISOR_WATCHDOG_TICK_MS
+/// Resolution of heartbeat timeouts and budget windows
+#    define THREAD_SUPERVISOR_WATCHDOG_TICK_MS 10
+#endif
+
+#ifndef THREAD_SUPERVISOR_WATCHDOG_QUEUE_SIZE
+/// Maximal number of threads waiting to be registered with the watchdog
+#    define THREAD_SUPERVISOR_WATCHDOG_QUEUE_SIZE 256
+#endif
 
 
 namespace tut
@@ -49,6 +79,38 @@ namespace tut
     }  // namespace log
 
 
+    namespace trace
+    {
+        /// Thread lifecycle events, see trace::Chrome
+        enum class Event : std::uint8_t
+        {
+            START = 0,          /// thread is started
+            ATTEMPT_BEGIN = 1,  /// thread function is called
+            ATTEMPT_END = 2,    /// thread function has returned or thrown
+            EXCEPTION = 3,      /// exception is intercepted
+            BACKOFF_BEGIN = 4,  /// waiting before restart
+            BACKOFF_END = 5,
+            DROP = 6,  /// thread is terminated
+            JOIN = 7   /// thread is joined by the supervisor
+        };
+
+
+        /// Loggers may implement tracing: trace(Event, <thread index>), which is not called otherwise
+        template <class t_Logger, class = void>
+        class IsEnabled : public std::false_type
+        {
+        };
+
+        template <class t_Logger>
+        class IsEnabled<
+                t_Logger,
+                std::void_t<decltype(std::declval<t_Logger &>().trace(Event::START, std::uint32_t()))>>
+          : public std::true_type
+        {
+        };
+    }  // namespace trace
+
+
     namespace thread
     {
         /// Thread parameters
@@ -73,15 +135,96 @@ namespace tut
             /// Restarting parameters
             class Restart
             {
+            public:
+                /// Exponential growth of delay between attempts
+                class Backoff
+                {
+                public:
+                    double factor_;             /// delay multiplier, 1 = constant delay
+                    std::size_t max_sleep_ms_;  /// upper bound on delay, 0 = unlimited
+                    double jitter_;             /// delay is randomly reduced by up to this fraction, [0, 1]
+
+                public:
+                    explicit Backoff(
+                            const double factor = 1.0,  // NOLINT
+                            const std::size_t max_sleep_ms = 0,
+                            const double jitter = 0.0)
+                    {
+                        factor_ = factor;
+                        max_sleep_ms_ = max_sleep_ms;
+                        jitter_ = jitter;
+                    }
+                };
+
+
+                /// Restart rate limit, thread is terminated when exceeded
+                class CircuitBreaker
+                {
+                public:
+                    std::size_t max_restarts_;  /// 0 = disabled
+                    std::size_t window_ms_;     /// sliding window duration
+
+                public:
+                    explicit CircuitBreaker(const std::size_t max_restarts = 0, const std::size_t window_ms = 0)  // NOLINT
+                    {
+                        max_restarts_ = max_restarts;
+                        window_ms_ = window_ms;
+                    }
+
+                    [[nodiscard]] bool isEnabled() const
+                    {
+                        return (0 != max_restarts_);
+                    }
+
+                    /**
+                     * Register a restart in the history of restart times.
+                     * @param[in,out] history restart times, resized on the first call
+                     * @param[in] restart restart index starting from 0
+                     * @return false if the limit is exceeded
+                     */
+                    bool check(std::vector<std::chrono::steady_clock::time_point> &history, const std::size_t restart)
+                            const
+                    {
+                        if (not isEnabled())
+                        {
+                            return (true);
+                        }
+
+                        if (history.size() != max_restarts_)
+                        {
+                            history.resize(max_restarts_);
+                        }
+
+                        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                        std::chrono::steady_clock::time_point &oldest = history[restart % max_restarts_];
+
+                        if (restart >= max_restarts_ and now - oldest < std::chrono::milliseconds(window_ms_))
+                        {
+                            return (false);
+                        }
+                        oldest = now;
+                        return (true);
+                    }
+                };
+
+
             public:
                 std::size_t attempts_;  /// 0 = unlimited
                 std::size_t sleep_ms_;  /// delay between attempts
+                Backoff backoff_;
+                CircuitBreaker circuit_breaker_;
 
             public:
-                explicit Restart(const std::size_t attempts = 0, const std::size_t sleep_ms = 0)  // NOLINT
+                explicit Restart(  // NOLINT
+                        const std::size_t attempts = 0,
+                        const std::size_t sleep_ms = 0,
+                        const Backoff &backoff = Backoff(),
+                        const CircuitBreaker &circuit_breaker = CircuitBreaker())
                 {
                     attempts_ = attempts;
                     sleep_ms_ = sleep_ms;
+                    backoff_ = backoff;
+                    circuit_breaker_ = circuit_breaker;
                 }
 
                 [[nodiscard]] bool isUnlimited() const
@@ -99,9 +242,40 @@ namespace tut
                     return (isOk(1));
                 }
 
-                void wait() const
+                /// Delay before the given attempt (starting from 1), random number generator is used for jitter
+                template <class t_Generator>
+                [[nodiscard]] std::chrono::milliseconds getDelay(const std::size_t attempt, t_Generator &generator)
+                        const
+                {
+                    const double max_sleep_ms = (0 == backoff_.max_sleep_ms_)
+                                                        ? static_cast<double>(std::numeric_limits<std::uint32_t>::max())
+                                                        : static_cast<double>(backoff_.max_sleep_ms_);
+
+                    double sleep_ms = static_cast<double>(sleep_ms_);
+                    if (attempt > 1 and sleep_ms > 0.0)
+                    {
+                        sleep_ms *= std::pow(backoff_.factor_, static_cast<double>(attempt - 1));
+                    }
+                    sleep_ms = std::min(sleep_ms, max_sleep_ms);
+
+                    if (backoff_.jitter_ > 0.0)
+                    {
+                        sleep_ms *= 1.0 - backoff_.jitter_ * std::uniform_real_distribution<double>(0.0, 1.0)(generator);
+                    }
+
+                    return (std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(sleep_ms)));
+                }
+
+                /// Sleep before the given attempt, returns false if the supervisor is interrupted
+                template <class t_Supervisor, class t_Generator>
+                bool wait(const t_Supervisor &supervisor, const std::size_t attempt, t_Generator &generator) const
                 {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms_));
+                    const std::chrono::milliseconds delay = getDelay(attempt, generator);
+                    if (0 == delay.count())
+                    {
+                        return (not supervisor.isInterrupted());
+                    }
+                    return (supervisor.sleepFor(delay));
                 }
             };
 
@@ -109,16 +283,78 @@ namespace tut
             /// Scheduling parameters, POSIX threads only, see pthread_setschedparam
             class Scheduling
             {
+            public:
+                /// CPU placement, Linux only, see pthread_setaffinity_np
+                class Affinity
+                {
+                public:
+                    enum class Placement
+                    {
+                        ANY,         /// thread may run on any of the selected CPUs
+                        ROUND_ROBIN  /// thread is pinned to a single selected CPU, CPUs are assigned in turn
+                    };
+
+                public:
+                    cpu::Set cpus_;        /// selected CPUs, empty = all CPUs available to the process
+                    int numa_node_;        /// restrict selection to CPUs of this NUMA node, -1 = any node
+                    Placement placement_;  /// placement strategy
+
+                public:
+                    explicit Affinity(
+                            cpu::Set cpus = cpu::Set(),  // NOLINT
+                            const int numa_node = -1,
+                            const Placement placement = Placement::ANY)
+                      : cpus_(std::move(cpus))
+                    {
+                        numa_node_ = numa_node;
+                        placement_ = placement;
+                    }
+
+                    [[nodiscard]] bool isEnabled() const
+                    {
+                        return (not cpus_.empty() or numa_node_ >= 0 or Placement::ANY != placement_);
+                    }
+
+                    /// Selected CPUs which are available to the process, empty on failure
+                    [[nodiscard]] cpu::Set getCPUs(const std::size_t placement_index) const
+                    {
+                        cpu::Set cpus = cpu::getAllowed();
+
+                        if (not cpus_.empty())
+                        {
+                            cpu::Set selected = cpus_;
+                            std::sort(selected.begin(), selected.end());
+                            cpus = cpu::intersect(cpus, selected);
+                        }
+
+                        if (numa_node_ >= 0)
+                        {
+                            cpus = cpu::intersect(cpus, cpu::getNUMANode(numa_node_));
+                        }
+
+                        if (Placement::ROUND_ROBIN == placement_ and not cpus.empty())
+                        {
+                            cpus = cpu::Set{ cpus[placement_index % cpus.size()] };
+                        }
+
+                        return (cpus);
+                    }
+                };
+
+
             public:
                 int priority_;          /// thread priority
                 int policy_;            /// thread policy
                 bool ignore_failures_;  /// proceed if scheduling parameters could not be set
+                Affinity affinity_;     /// CPU placement
 
             public:
                 explicit Scheduling(
                         const int priority = 0,         // NOLINT
                         const int policy = SCHED_FIFO,  // NOLINT
-                        const bool ignore_failures = true)
+                        const bool ignore_failures = true,
+                        Affinity affinity = Affinity())
+                  : affinity_(std::move(affinity))
                 {
                     priority_ = priority;
                     policy_ = policy;
@@ -126,7 +362,13 @@ namespace tut
                 }
 
 
-                bool apply(const std::thread::native_handle_type &&handle) const  // NOLINT return value can be ignored
+                /**
+                 * @param[in] handle thread handle
+                 * @param[in] placement_index sequential number used for round-robin placement
+                 */
+                bool apply(  // NOLINT return value can be ignored
+                        const std::thread::native_handle_type &&handle,
+                        const std::size_t placement_index = 0) const
                 {
                     if (SCHED_FIFO != policy_ or 0 != priority_)  // custom parameters
                     {
@@ -138,14 +380,276 @@ namespace tut
                             return (false);
                         }
                     }
+
+                    if (affinity_.isEnabled())
+                    {
+                        const cpu::Set cpus = affinity_.getCPUs(placement_index);
+                        if (cpus.empty() or not cpu::setAffinity(handle, cpus))
+                        {
+                            return (false);
+                        }
+                    }
+
                     return (true);
                 }
             };
 
 
+            /// Hang detection, see Supervisor::heartbeat()
+            class Heartbeat
+            {
+            public:
+                /// What to do when heartbeat timeout is exceeded
+                enum class Action
+                {
+                    LOG,       /// report stall
+                    TERMINATE  /// report stall, stop the thread without restart, and apply termination policy
+                };
+
+            public:
+                std::size_t timeout_ms_;  /// 0 = disabled
+                Action action_;
+
+            public:
+                explicit Heartbeat(const std::size_t timeout_ms = 0, const Action action = Action::LOG)  // NOLINT
+                {
+                    timeout_ms_ = timeout_ms;
+                    action_ = action;
+                }
+
+                [[nodiscard]] bool isEnabled() const
+                {
+                    return (0 != timeout_ms_);
+                }
+            };
+
+
+            /**
+             * Periodic execution: thread function performs a single iteration
+             * and is called repeatedly at absolute deadlines until the
+             * supervisor is interrupted.
+             */
+            class Period
+            {
+            public:
+                enum class Mode
+                {
+                    FIXED_RATE,  /// iterations start at multiples of the period
+                    FIXED_DELAY  /// period is counted from the end of the previous iteration
+                };
+
+                /// What to do when an iteration takes longer than the period (fixed rate only)
+                enum class Overrun
+                {
+                    SKIP,      /// skip missed deadlines
+                    CATCH_UP,  /// start missed iterations immediately
+                    ESCALATE   /// stop the thread and apply termination policy
+                };
+
+            public:
+                std::size_t period_us_;  /// 0 = disabled
+                Mode mode_;
+                Overrun overrun_;
+
+            public:
+                explicit Period(  // NOLINT
+                        const std::size_t period_us = 0,
+                        const Mode mode = Mode::FIXED_RATE,
+                        const Overrun overrun = Overrun::SKIP)
+                {
+                    period_us_ = period_us;
+                    mode_ = mode;
+                    overrun_ = overrun;
+                }
+
+                [[nodiscard]] bool isEnabled() const
+                {
+                    return (0 != period_us_);
+                }
+            };
+
+
+            /**
+             * Graceful shutdown order, see Supervisor::shutdown(): threads
+             * are stopped in phases, lower phases first, e.g., ingress threads
+             * should be stopped before processing threads and sinks.
+             */
+            class Shutdown
+            {
+            public:
+                std::size_t phase_;
+                std::size_t timeout_ms_;  /// 0 = timeout passed to Supervisor::shutdown()
+
+            public:
+                explicit Shutdown(const std::size_t phase = 0, const std::size_t timeout_ms = 0)  // NOLINT
+                {
+                    phase_ = phase;
+                    timeout_ms_ = timeout_ms;
+                }
+            };
+
+
+            /**
+             * OS thread name, Linux only, see pthread_setname_np: visible in
+             * `top -H`, perf, and gdb. The name is suffixed with the replica
+             * index and the restart number, e.g., "decoder.3+2", and is
+             * truncated to the OS limit, the base name is cut first.
+             */
+            class Name
+            {
+            public:
+                /// Linux limit excluding terminating null
+                static constexpr std::size_t MAX_LENGTH = 15;
+                static constexpr std::size_t NO_REPLICA = std::numeric_limits<std::size_t>::max();
+
+            public:
+                std::string name_;     /// empty = thread name is not changed
+                std::size_t replica_;  /// replica index, see WorkerGroup
+
+            public:
+                explicit Name(std::string name = "", const std::size_t replica = NO_REPLICA)  // NOLINT
+                  : name_(std::move(name))
+                {
+                    replica_ = replica;
+                }
+
+                [[nodiscard]] bool isEnabled() const
+                {
+                    return (not name_.empty());
+                }
+
+                /// Name of the given attempt (starting from 0)
+                [[nodiscard]] std::string format(const std::size_t attempt) const
+                {
+                    std::string suffix;
+                    if (NO_REPLICA != replica_)
+                    {
+                        suffix += "." + std::to_string(replica_);
+                    }
+                    if (attempt > 0)
+                    {
+                        suffix += "+" + std::to_string(attempt);
+                    }
+
+                    if (suffix.size() >= MAX_LENGTH)
+                    {
+                        return (name_.substr(0, 1) + suffix.substr(suffix.size() - (MAX_LENGTH - 1)));
+                    }
+                    return (name_.substr(0, MAX_LENGTH - suffix.size()) + suffix);
+                }
+            };
+
+
+            /**
+             * Thread-local memory arena, see Supervisor::getMemoryResource().
+             * The arena is allocated by the thread after scheduling
+             * parameters are applied, so that its pages are local to the
+             * selected NUMA node, and is reset before each restart instead of
+             * being freed.
+             */
+            class Arena
+            {
+            public:
+                std::size_t size_;  /// bytes, 0 = disabled
+                bool prefault_;     /// touch all pages before the first attempt
+
+            public:
+                explicit Arena(const std::size_t size = 0, const bool prefault = false)  // NOLINT
+                {
+                    size_ = size;
+                    prefault_ = prefault;
+                }
+
+                [[nodiscard]] bool isEnabled() const
+                {
+                    return (0 != size_);
+                }
+            };
+
+
+            /**
+             * Resource limits, checked periodically by the watchdog thread,
+             * see Parameters::Heartbeat. Memory usage is tracked only for
+             * allocations via Supervisor::getMemoryResource().
+             */
+            class Budget
+            {
+            public:
+                /// What to do when a budget is exceeded
+                enum class Action
+                {
+                    LOG,       /// report
+                    DEMOTE,    /// report and switch the thread to SCHED_IDLE policy (Linux), once
+                    TERMINATE  /// report and stop the thread without restart, termination policy is applied
+                };
+
+            public:
+                std::size_t cpu_ms_;        /// CPU time per window, 0 = unlimited
+                std::size_t window_ms_;     /// CPU time measurement window
+                std::size_t memory_bytes_;  /// 0 = unlimited
+                Action action_;
+
+            public:
+                explicit Budget(  // NOLINT
+                        const std::size_t cpu_ms = 0,
+                        const std::size_t window_ms = 1000,
+                        const std::size_t memory_bytes = 0,
+                        const Action action = Action::LOG)
+                {
+                    cpu_ms_ = cpu_ms;
+                    window_ms_ = window_ms;
+                    memory_bytes_ = memory_bytes;
+                    action_ = action;
+                }
+
+                [[nodiscard]] bool isEnabled() const
+                {
+                    return ((0 != cpu_ms_ and 0 != window_ms_) or 0 != memory_bytes_);
+                }
+            };
+
+
+            /**
+             * Called by the thread after an exception is intercepted with
+             * ExceptionPolicy::CATCH, decides what to do next. The report
+             * is also available via Supervisor::getCrashReports().
+             */
+            class ExceptionHandler
+            {
+            public:
+                enum class Action
+                {
+                    RESTART,   /// restart according to Parameters::Restart
+                    ESCALATE,  /// terminate the thread and apply termination policy
+                    KILLALL    /// interrupt the supervisor
+                };
+
+            public:
+                std::function<Action(const CrashReport &)> handler_;  /// empty = always restart
+
+            public:
+                explicit ExceptionHandler(std::function<Action(const CrashReport &)> handler = nullptr)  // NOLINT
+                  : handler_(std::move(handler))
+                {
+                }
+
+                [[nodiscard]] Action handle(const CrashReport &report) const
+                {
+                    return (handler_ ? handler_(report) : Action::RESTART);
+                }
+            };
+
+
         public:
             Restart restart_;
             Scheduling scheduling_;
+            Heartbeat heartbeat_;
+            Budget budget_;
+            ExceptionHandler exception_handler_;
+            Period period_;
+            Shutdown shutdown_;
+            Name name_;
+            Arena arena_;
 
 #ifdef THREAD_SUPERVISOR_THOU_SHALT_NOT_PASS  /// do not allow threads to exit / crash quietly
             TerminationPolicy termination_policy_ = TerminationPolicy::KILLALL;
@@ -171,6 +675,55 @@ namespace tut
                 scheduling_ = scheduling;
             }
 
+            template <class... t_Args>
+            Parameters(const Heartbeat &&heartbeat, t_Args &&...args)  // NOLINT noexplicit
+              : Parameters(std::forward<t_Args>(args)...)
+            {
+                heartbeat_ = heartbeat;
+            }
+
+            template <class... t_Args>
+            Parameters(const Budget &&budget, t_Args &&...args)  // NOLINT noexplicit
+              : Parameters(std::forward<t_Args>(args)...)
+            {
+                budget_ = budget;
+            }
+
+            template <class... t_Args>
+            Parameters(const ExceptionHandler &&exception_handler, t_Args &&...args)  // NOLINT noexplicit
+              : Parameters(std::forward<t_Args>(args)...)
+            {
+                exception_handler_ = exception_handler;
+            }
+
+            template <class... t_Args>
+            Parameters(const Shutdown &&shutdown, t_Args &&...args)  // NOLINT noexplicit
+              : Parameters(std::forward<t_Args>(args)...)
+            {
+                shutdown_ = shutdown;
+            }
+
+            template <class... t_Args>
+            Parameters(const Period &&period, t_Args &&...args)  // NOLINT noexplicit
+              : Parameters(std::forward<t_Args>(args)...)
+            {
+                period_ = period;
+            }
+
+            template <class... t_Args>
+            Parameters(const Name &&name, t_Args &&...args)  // NOLINT noexplicit
+              : Parameters(std::forward<t_Args>(args)...)
+            {
+                name_ = name;
+            }
+
+            template <class... t_Args>
+            Parameters(const Arena &&arena, t_Args &&...args)  // NOLINT noexplicit
+              : Parameters(std::forward<t_Args>(args)...)
+            {
+                arena_ = arena;
+            }
+
             template <class... t_Args>
             Parameters(const TerminationPolicy termination_policy, t_Args &&...args)  // NOLINT noexplicit
               : Parameters(std::forward<t_Args>(args)...)
@@ -194,39 +747,327 @@ namespace tut
         class Supervisor;
 
 
-        /// Thread handling class
-        class Thread
+        /**
+         * Blocking primitive that waits for interrupts, e.g., a channel, see
+         * Supervisor::subscribe(). Waiters must check
+         * Supervisor::isInterrupted() while holding the mutex that
+         * @ref notifyInterrupt locks before notifying them, so that wake ups
+         * are not lost.
+         */
+        class InterruptListener
         {
-            // THREAD_SUPERVISOR_DISABLE_CLASS_COPY(Thread)
-
         public:
-            using List = std::list<Thread>;
-            using Reference = List::iterator;
+            /// Called on Supervisor::interrupt() and on stop requests of individual threads
+            virtual void notifyInterrupt() = 0;
 
-        public:
-            Parameters parameters_;
-            std::thread thread_;
-            Reference self_;
+        protected:
+            InterruptListener() = default;
+            InterruptListener(const InterruptListener &) = default;
+            InterruptListener &operator=(const InterruptListener &) = default;
+            ~InterruptListener() = default;
+        };
 
 
+        /**
+         * Holds threads of a batch before their functions are called until
+         * all of them are initialized, see Supervisor::Batch. Waiting is
+         * cancelled on shutdown, the barrier must be subscribed to the
+         * supervisor for this, see Supervisor::subscribe().
+         */
+        class StartBarrier : public InterruptListener
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(StartBarrier)
+
         protected:
-            template <class t_Logger, class t_Function, class... t_Args>
-            void startOnce(Supervisor<t_Logger> *supervisor, t_Function &&function, t_Args &&...args)
+            std::mutex mutex_;
+            std::condition_variable condition_;
+            std::size_t arrived_;
+            std::size_t expected_;
+
+        protected:
+            [[nodiscard]] bool isOpen() const
             {
-                switch (parameters_.exception_policy_)
-                {
+                return (arrived_ >= expected_);
+            }
+
+        public:
+            StartBarrier()
+            {
+                arrived_ = 0;
+                expected_ = std::numeric_limits<std::size_t>::max();
+            }
+
+            /**
+             * Called by a thread, blocks until the barrier is opened or the
+             * predicate returns true, returns false in the latter case.
+             */
+            template <class t_Cancelled>
+            bool arriveAndWait(t_Cancelled &&cancelled)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ++arrived_;
+                if (isOpen())
+                {
+                    condition_.notify_all();
+                }
+                else
+                {
+                    condition_.wait(lock, [this, &cancelled]() { return (isOpen() or cancelled()); });
+                }
+                return (isOpen());
+            }
+
+            /// Open the barrier when the given number of threads has arrived
+            void release(const std::size_t expected)
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                expected_ = expected;
+                condition_.notify_all();
+            }
+
+            /// Waiting threads check cancellation
+            void notifyInterrupt() override
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                condition_.notify_all();
+            }
+        };
+
+
+        /// Thread handling class
+        class Thread
+        {
+            // THREAD_SUPERVISOR_DISABLE_CLASS_COPY(Thread)
+
+        public:
+            using Reference = RegistryHandle;
+            using Registry = thread::Registry<Thread>;
+
+        public:
+            Parameters parameters_;
+            std::thread thread_;
+            Reference self_;
+            MetricsCounters metrics_;
+
+            /// incremented by the thread, checked by the watchdog
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<std::size_t> heartbeat_;
+            /// heartbeat is not expected while the thread is waiting for restart
+            std::atomic<bool> heartbeat_suspended_;
+
+            /// order of addition to the supervisor, used by restart strategies
+            std::atomic<std::size_t> sequence_;
+            /// thread is restarted by the group, see Supervisor::Strategy
+            std::atomic<bool> restartable_;
+            /// end the current attempt and restart, does not affect other threads
+            std::atomic<bool> stop_requested_;
+            /// end the current attempt without restart, see Supervisor::shutdown()
+            std::atomic<bool> shutdown_requested_;
+            /// owned and used only by the thread, see Parameters::Arena
+            thread::Arena *arena_;
+            /// see Supervisor::getMemoryResource(), nullptr = default resource
+            std::pmr::memory_resource *memory_resource_;
+            /// written by the thread, checked by the watchdog, see Parameters::Budget
+            std::atomic<std::size_t> allocated_bytes_;
+            /// thread is initialized and is about to call its function, see Supervisor::waitReady()
+            std::atomic<bool> ready_;
+            /// set by the supervisor before the thread is started, taken by the thread, see Supervisor::Batch
+            std::shared_ptr<StartBarrier> barrier_;
+            /// service thread of the supervisor (watchdog), hidden from metrics, crash reports, and shutdown phases
+            bool internal_ = false;
+            /// held by the thread when it exits and by other threads using its handle or CPU clock
+            mutable std::mutex exit_mutex_;
+            /// guarded by exit_mutex_, native handle and CPU clock are invalid when set
+            bool exited_ = true;
+            /// written only by the thread, allocated with the thread slot and reused
+            CrashReport crash_report_;
+            mutable std::mutex crash_report_mutex_;
+
+
+        protected:
+            /// Thread object of the calling thread, nullptr if the thread is not supervised
+            static Thread *&getCurrentReference()
+            {
+                thread_local Thread *current = nullptr;
+                return (current);
+            }
+
+
+            /// Callable is a tuple (<function>, <arguments>...), arguments are passed as lvalues to be reused on restart
+            template <class t_Callable>
+            static void invoke(t_Callable &callable)
+            {
+                std::apply([](auto &...items) { std::invoke(items...); }, callable);
+            }
+
+
+            /// Set OS name of the calling thread for the given attempt, see Parameters::Name
+            template <class t_Logger>
+            void applyName(Supervisor<t_Logger> *supervisor, const std::size_t attempt)
+            {
+                if (parameters_.name_.isEnabled())
+                {
+                    const std::string name = parameters_.name_.format(attempt);
+                    if (0 != pthread_setname_np(pthread_self(), name.c_str()))
+                    {
+                        supervisor->log("Supervisor error: could not set thread name: ", name);
+                    }
+                    supervisor->setThreadName(metrics_.getTid(), name);
+                }
+            }
+
+
+            template <class t_Logger>
+            bool isTerminating(const Supervisor<t_Logger> *supervisor) const
+            {
+                return (supervisor->isSupervisorInterrupted() or shutdown_requested_.load());
+            }
+
+
+            /// Returns false if a missed deadline must be escalated
+            template <class t_Logger, class t_Callable>
+            bool call(Supervisor<t_Logger> *supervisor, t_Callable &callable)
+            {
+                if (not parameters_.period_.isEnabled())
+                {
+                    invoke(callable);
+                    return (true);
+                }
+
+                const std::chrono::microseconds period(parameters_.period_.period_us_);
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+                // the last deadline counted as missed, catch-up iterations must not count it again
+                std::chrono::steady_clock::time_point last_missed = deadline;
+
+                for (;;)
+                {
+                    invoke(callable);
+
+                    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                    if (Parameters::Period::Mode::FIXED_DELAY == parameters_.period_.mode_)
+                    {
+                        deadline = now + period;
+                    }
+                    else
+                    {
+                        deadline += period;
+                        const std::chrono::steady_clock::time_point first_uncounted =
+                                std::max(deadline, last_missed + period);
+                        if (now > first_uncounted)
+                        {
+                            const std::size_t missed = static_cast<std::size_t>((now - first_uncounted) / period) + 1;
+                            metrics_.addMissedDeadlines(missed);
+                            last_missed = first_uncounted + period * (missed - 1);
+
+                            switch (parameters_.period_.overrun_)
+                            {
+                                case Parameters::Period::Overrun::SKIP:
+                                    deadline += period * missed;
+                                    break;
+
+                                case Parameters::Period::Overrun::CATCH_UP:
+                                    break;
+
+                                case Parameters::Period::Overrun::ESCALATE:
+                                    supervisor->log("Supervisor / thread missed deadline: ", missed);
+                                    return (false);
+
+                                default:
+                                    supervisor->log("Supervisor error: unknown overrun handling type");
+                                    break;
+                            }
+                        }
+                    }
+
+                    // absolute deadline on the monotonic clock
+                    if (not supervisor->waitUntil(deadline))
+                    {
+                        return (true);
+                    }
+                    metrics_.addPeriod(std::chrono::steady_clock::now() - deadline);
+                }
+            }
+
+
+            /**
+             * Must be called from a catch block: record the current
+             * exception in the crash report and ask the handler what to do
+             * next, returns false if the thread must not be restarted.
+             */
+            template <class t_Logger>
+            bool handleException(Supervisor<t_Logger> *supervisor, const std::size_t attempt)
+            {
+                supervisor->traceEvent(trace::Event::EXCEPTION, self_);
+
+                const std::type_info *type = abi::__cxa_current_exception_type();
+                metrics_.stopAttempt(nullptr == type ? typeid(void) : *type);
+                {
+                    // the lock protects readers, the thread is the only writer
+                    const std::lock_guard<std::mutex> lock(crash_report_mutex_);
+
+                    crash_report_.reference_ = self_;
+                    crash_report_.exception_ = std::current_exception();
+                    crash_report_.type_ = type;
+                    crash_report_.time_ = std::chrono::system_clock::now();
+                    crash_report_.attempt_ = attempt;
+                }
+
+                // the report is lost when the slot is reused, formatting cost is up to the logger, e.g., log::Async
+                const std::string message = crash_report_.getMessage();
+                supervisor->log(
+                        "Supervisor / intercepted thread exception: ",
+                        crash_report_.getTypeName(),
+                        message.empty() ? "" : " / ",
+                        message);
+
+                switch (parameters_.exception_handler_.handle(crash_report_))
+                {
+                    case Parameters::ExceptionHandler::Action::RESTART:
+                        return (true);
+
+                    case Parameters::ExceptionHandler::Action::ESCALATE:
+                        supervisor->log("Supervisor / thread exception escalated: ", self_.index_);
+                        return (false);
+
+                    case Parameters::ExceptionHandler::Action::KILLALL:
+                        supervisor->log("Supervisor / thread exception escalated, interrupting: ", self_.index_);
+                        supervisor->interrupt();
+                        return (false);
+
+                    default:
+                        supervisor->log("Supervisor error: unknown exception handler action");
+                        return (true);
+                }
+            }
+
+
+            /// Returns false if the thread must not be restarted
+            template <class t_Logger, class t_Callable>
+            bool startOnce(Supervisor<t_Logger> *supervisor, t_Callable &callable, const std::size_t attempt)
+            {
+                supervisor->traceEvent(trace::Event::ATTEMPT_BEGIN, self_);
+
+                bool result = true;
+                switch (parameters_.exception_policy_)
+                {
                     case Parameters::ExceptionPolicy::PASS:
-                        std::bind(function, std::forward<t_Args>(args)...)();
+                        result = call(supervisor, callable);
+                        metrics_.stopAttempt();
                         break;
 
                     case Parameters::ExceptionPolicy::CATCH:
                         try
                         {
-                            std::bind(function, std::forward<t_Args>(args)...)();
+                            result = call(supervisor, callable);
+                            metrics_.stopAttempt();
                         }
-                        catch (const std::exception &e)
+                        catch (abi::__forced_unwind &)
                         {
-                            supervisor->log("Supervisor / intercepted thread exception: ", e.what());
+                            // thread cancellation must unwind the stack
+                            throw;
+                        }
+                        catch (...)
+                        {
+                            result = handleException(supervisor, attempt);
                         }
                         break;
 
@@ -234,20 +1075,45 @@ namespace tut
                         supervisor->log("Supervisor error: unknown exception handling type");
                         break;
                 }
+                supervisor->traceEvent(trace::Event::ATTEMPT_END, self_);
+                return (result);
             }
 
 
-            template <class t_Logger, class t_Function, class... t_Args>
-            void startLoop(Supervisor<t_Logger> *supervisor, t_Function &&function, t_Args &&...args)
+            template <class t_Logger, class t_Callable>
+            void startLoop(Supervisor<t_Logger> *supervisor, t_Callable &callable)
             {
-                bool started = false;
-                for (std::size_t attempt = 0; parameters_.restart_.isOk(attempt) and not supervisor->isInterrupted();
+                std::minstd_rand random_generator(static_cast<std::minstd_rand::result_type>(
+                        std::hash<std::thread::id>()(std::this_thread::get_id())
+                        ^ static_cast<std::size_t>(std::chrono::steady_clock::now().time_since_epoch().count())));
+                std::vector<std::chrono::steady_clock::time_point> restart_history;
+
+                for (std::size_t attempt = 0; parameters_.restart_.isOk(attempt) and not isTerminating(supervisor);
                      ++attempt)
                 {
-                    if (started)
+                    if (attempt > 0)
                     {
-                        parameters_.restart_.wait();
-                        if (supervisor->isInterrupted())
+                        if (not parameters_.restart_.circuit_breaker_.check(restart_history, attempt - 1))
+                        {
+                            supervisor->log(
+                                    "Supervisor / restart limit exceeded: ",
+                                    parameters_.restart_.circuit_breaker_.max_restarts_,
+                                    " restarts per ",
+                                    parameters_.restart_.circuit_breaker_.window_ms_,
+                                    " ms");
+                            break;
+                        }
+
+                        const std::chrono::steady_clock::time_point backoff_start = std::chrono::steady_clock::now();
+                        heartbeat_suspended_.store(true, std::memory_order_relaxed);
+                        supervisor->traceEvent(trace::Event::BACKOFF_BEGIN, self_);
+                        const bool completed = parameters_.restart_.wait(*supervisor, attempt, random_generator);
+                        supervisor->traceEvent(trace::Event::BACKOFF_END, self_);
+                        heartbeat();
+                        heartbeat_suspended_.store(false, std::memory_order_relaxed);
+                        metrics_.addBackoffTime(std::chrono::steady_clock::now() - backoff_start);
+                        // stop request cuts the delay short, but does not prevent restart
+                        if (not completed and isTerminating(supervisor))
                         {
                             break;
                         }
@@ -257,29 +1123,107 @@ namespace tut
                                 attempt + 1,
                                 " / ",
                                 parameters_.restart_.isUnlimited() ? 0 : parameters_.restart_.attempts_);
+                        applyName(supervisor, attempt);
                     }
-                    else
+
+                    if (nullptr != arena_)
+                    {
+                        arena_->reset();
+                        allocated_bytes_.store(0, std::memory_order_relaxed);
+                    }
+
+                    // pending stop requests are served by this restart, shutdown request must be checked after
+                    // clearing since it is accompanied by a stop request
+                    stop_requested_.store(false);
+                    if (isTerminating(supervisor))
+                    {
+                        break;
+                    }
+
+                    metrics_.startAttempt(attempt);
+                    if (not startOnce(supervisor, callable, attempt))
                     {
-                        started = true;
+                        break;
                     }
 
-                    startOnce(supervisor, function, std::forward<t_Args>(args)...);
+                    // threads stopped by the group do not trigger further group restarts
+                    if (not stop_requested_.load(std::memory_order_relaxed)
+                        and parameters_.restart_.isOk(attempt + 1))
+                    {
+                        supervisor->restartGroup(*this);
+                    }
                 }
             }
 
 
-            template <class t_Logger, class t_Function, class... t_Args>
-            void startThread(Supervisor<t_Logger> *supervisor, t_Function &&function, t_Args &&...args)
+            /// Callable is stored by std::thread once for the lifetime of the thread
+            template <class t_Logger, class t_Callable>
+            void startThread(
+                    Supervisor<t_Logger> *supervisor,
+                    const std::size_t placement_index,
+                    std::promise<bool> started,
+                    std::future<void> published,
+                    t_Callable &&callable)
             {
-                if (parameters_.restart_.isEnabled())
+                const std::shared_ptr<StartBarrier> barrier = std::move(barrier_);
+
+                // configure the thread before running its function, the parent is blocked until the result is
+                // reported; the promise is owned by the thread, since the parent may return before set_value() does
+                const bool scheduling_applied = parameters_.scheduling_.apply(pthread_self(), placement_index);
+                started.set_value(scheduling_applied);
+                // the thread must not terminate before the parent has initialized and published its slot
+                published.wait();
+
+                metrics_.startThread();
+                supervisor->traceEvent(trace::Event::START, self_);
+                getCurrentReference() = this;
+                applyName(supervisor, 0);
+
+                if (not scheduling_applied and not parameters_.scheduling_.ignore_failures_)
                 {
-                    startLoop(supervisor, function, std::forward<t_Args>(args)...);
+                    exit();
+                    supervisor->drop(self_);
+                    return;
                 }
-                else
+
+                // allocated after scheduling parameters are applied for locality
+                std::unique_ptr<thread::Arena> arena;
+                if (parameters_.arena_.isEnabled())
+                {
+                    arena = std::make_unique<thread::Arena>(parameters_.arena_.size_, parameters_.arena_.prefault_);
+                    arena_ = arena.get();
+                    memory_resource_ = arena->get();
+                }
+
+                std::unique_ptr<CountingResource> counting_resource;
+                if (0 != parameters_.budget_.memory_bytes_)
+                {
+                    counting_resource = std::make_unique<CountingResource>(
+                            nullptr == memory_resource_ ? std::pmr::get_default_resource() : memory_resource_,
+                            &allocated_bytes_);
+                    memory_resource_ = counting_resource.get();
+                }
+
+                ready_.store(true);
+                supervisor->notifyWaiters();
+
+                // the function is not called if shutdown starts before the batch
+                if (nullptr == barrier
+                    or barrier->arriveAndWait([this, supervisor]() { return (isTerminating(supervisor)); }))
                 {
-                    startOnce(supervisor, function, std::forward<t_Args>(args)...);
+                    if (parameters_.restart_.isEnabled())
+                    {
+                        startLoop(supervisor, callable);
+                    }
+                    else
+                    {
+                        metrics_.startAttempt(0);
+                        startOnce(supervisor, callable, 0);
+                    }
                 }
 
+                exit();
+
 
                 switch (parameters_.termination_policy_)
                 {
@@ -300,28 +1244,87 @@ namespace tut
 
 
         public:
+            /**
+             * Initialize the slot, start the thread, and publish the slot, see
+             * Registry::publish(). Returns false if the thread function is
+             * not going to be executed due to scheduling failure.
+             */
             template <class t_Logger, class... t_Args>
-            void start(
+            bool start(
                     Supervisor<t_Logger> *supervisor,
                     Reference self,
                     const Parameters &&parameters,
                     t_Args &&...args)
             {
-                self_ = self;
+                {
+                    // a stale reference to the previous thread in this slot must not match
+                    const std::lock_guard<std::mutex> lock(exit_mutex_);
+                    self_ = self;
+                    exited_ = false;
+                }
                 parameters_ = parameters;
+                metrics_.reset();
+                heartbeat_ = 0;
+                heartbeat_suspended_ = false;
+                sequence_ = internal_ ? std::numeric_limits<std::size_t>::max() : supervisor->getSequenceNumber();
+                restartable_ = parameters_.restart_.isEnabled();
+                stop_requested_ = false;
+                shutdown_requested_ = false;
+                {
+                    const std::lock_guard<std::mutex> lock(crash_report_mutex_);
+                    crash_report_.exception_ = nullptr;
+                }
+                arena_ = nullptr;
+                memory_resource_ = nullptr;
+                allocated_bytes_ = 0;
+                ready_ = false;
+
+                const std::size_t placement_index =
+                        (Parameters::Scheduling::Affinity::Placement::ROUND_ROBIN
+                         == parameters_.scheduling_.affinity_.placement_)
+                                ? supervisor->getPlacementIndex()
+                                : 0;
+
+                std::promise<bool> started;
+                std::future<bool> scheduling_applied = started.get_future();
+                std::promise<void> published;
+
+                using Callable = std::tuple<std::decay_t<t_Args>...>;
                 thread_ = std::thread(
-                        &Thread::startThread<t_Logger, t_Args...>, this, supervisor, std::forward<t_Args>(args)...);
-
-                if (not parameters_.scheduling_.apply(thread_.native_handle()))
+                        &Thread::startThread<t_Logger, Callable>,
+                        this,
+                        supervisor,
+                        placement_index,
+                        std::move(started),
+                        published.get_future(),
+                        Callable(std::forward<t_Args>(args)...));
+
+                supervisor->publish(*this);
+                published.set_value();
+
+                if (not scheduling_applied.get())
                 {
                     supervisor->log("Supervisor error: could not configure custom thread scheduling.");
-                    if (not parameters_.scheduling_.ignore_failures_)
-                    {
-                        std::terminate();
-                    }
+                    return (parameters_.scheduling_.ignore_failures_);
                 }
+                return (true);
+            }
+
+            /// Thread object of the calling thread, nullptr if the thread is not supervised
+            static Thread *getCurrent()
+            {
+                return (getCurrentReference());
             }
 
+
+            /// Report that the thread is alive, called by the thread itself
+            void heartbeat()
+            {
+                // single writer
+                heartbeat_.store(heartbeat_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+
             void join()
             {
                 if (thread_.joinable())
@@ -329,17 +1332,129 @@ namespace tut
                     thread_.join();
                 }
             }
+
+
+            /**
+             * Call the function while the referenced thread is prevented from
+             * exiting, so that its native handle and CPU clock stay valid.
+             * Returns false without calling the function if the thread has
+             * exited, or the slot belongs to another thread.
+             */
+            template <class t_Function>
+            bool callWhileRunning(const Reference &reference, t_Function &&function) const
+            {
+                const std::lock_guard<std::mutex> lock(exit_mutex_);
+                if (exited_ or reference != self_)
+                {
+                    return (false);
+                }
+                function();
+                return (true);
+            }
+
+
+            /// CPU time consumed by the referenced thread, -1 if it is not running, see @ref callWhileRunning
+            [[nodiscard]] std::int64_t getCPUTime(const Reference &reference) const
+            {
+                std::int64_t cpu_time_ns = -1;
+                callWhileRunning(reference, [this, &cpu_time_ns]() { cpu_time_ns = metrics_.getCurrentCPUTime(); });
+                return (cpu_time_ns);
+            }
+
+
+            /// Metrics snapshot, the CPU clock is not used after the thread exits
+            [[nodiscard]] Metrics getMetrics(const Reference &reference) const
+            {
+                const std::lock_guard<std::mutex> lock(exit_mutex_);
+                return (metrics_.get(reference));
+            }
+
+
+        protected:
+            /// Called by the thread before its slot is dropped, see @ref callWhileRunning
+            void exit()
+            {
+                const std::lock_guard<std::mutex> lock(exit_mutex_);
+                exited_ = true;
+                metrics_.stopThread();
+            }
+        };
+
+
+
+        /**
+         * Stop request flag of a supervised thread, see
+         * Supervisor::getStopToken(). Cheaper alternative to
+         * Supervisor::isInterrupted() for hot loops: a single relaxed load of
+         * a flag owned by the thread.
+         */
+        class StopToken
+        {
+        protected:
+            const std::atomic<bool> *flag_;
+
+        public:
+            explicit StopToken(const std::atomic<bool> *flag) : flag_(flag)
+            {
+            }
+
+            /// Set on interrupt, shutdown, retirement, or group restart
+            [[nodiscard]] bool isStopRequested() const
+            {
+                return (flag_->load(std::memory_order_relaxed));
+            }
+        };
+
+
+        /// Result of Supervisor::shutdown()
+        class ShutdownReport
+        {
+        public:
+            /// Thread that did not terminate before its shutdown deadline
+            class Entry
+            {
+            public:
+                RegistryHandle reference_;
+                std::size_t phase_;
+                std::size_t timeout_ms_;
+            };
+
+        public:
+            std::vector<Entry> missed_deadlines_;
+            /// false if some threads were still running when shutdown returned
+            bool complete_ = true;
+
+        public:
+            [[nodiscard]] bool isOk() const
+            {
+                return (complete_ and missed_deadlines_.empty());
+            }
         };
 
 
 
-        /// Thread supervisor
+        /**
+         * Thread supervisor. Supervisors can be nested to form a tree: each
+         * supervisor is a group of threads with its own interrupt flag and
+         * restart strategy. Interrupts propagate from parents to children,
+         * but not in the opposite direction.
+         */
         template <class t_Logger>
         class Supervisor : public t_Logger
         {
             friend class Thread;
             THREAD_SUPERVISOR_DISABLE_CLASS_COPY(Supervisor)
 
+        public:
+            /// Reaction of the group to the end of an attempt of a thread, applies only to threads with restarts
+            enum class Strategy
+            {
+                ONE_FOR_ONE = 0,  /// restart only the thread
+                ONE_FOR_ALL = 1,  /// restart all threads of the group
+                REST_FOR_ONE = 2  /// restart the thread and threads added after it
+            };
+
+
         protected:
             enum class Status
             {
@@ -350,91 +1465,729 @@ namespace tut
 
 
         protected:
-            std::atomic<Status> status_;
+            /// polled by all threads, isolated from frequently written members
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<Status> status_;
 
-            std::mutex threads_mutex_;
-            Thread::List threads_;
-
-            std::mutex terminated_threads_mutex_;
-            std::list<Thread::Reference> terminated_threads_;
+            alignas(THREAD_SUPERVISOR_CACHE_LINE_SIZE) std::atomic<std::size_t> placement_counter_;
+            std::atomic<std::size_t> sequence_counter_;
 
+            const Strategy strategy_;
+            Supervisor *const parent_;
+            std::mutex children_mutex_;
+            std::vector<Supervisor *> children_;
 
-        protected:
-            bool wait(const std::size_t wait_ms)
-            {
-                const std::size_t sleep_ms = 10;
+            mutable std::mutex interrupt_mutex_;
+            mutable std::condition_variable interrupt_condition_;
 
-                {
-                    const std::lock_guard<std::mutex> lock(threads_mutex_);
-                    std::size_t counter = 0;
-                    for (;;)
-                    {
-                        if (counter * sleep_ms < wait_ms)
-                        {
-                            {
-                                const std::lock_guard<std::mutex> terminated_lock(terminated_threads_mutex_);
+            /// see @ref subscribe
+            mutable std::mutex listeners_mutex_;
+            mutable std::vector<InterruptListener *> listeners_;
 
-                                for (const Thread::Reference &thread_ref : terminated_threads_)
-                                {
-                                    thread_ref->join();
-                                    threads_.erase(thread_ref);
-                                }
-                                terminated_threads_.clear();
-                            }
+            Thread::Registry threads_;
 
-                            if (not threads_.empty())
-                            {
-                                std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
-                                ++counter;
-                            }
-                            else
-                            {
-                                return (true);
-                            }
-                        }
-                        else
-                        {
-                            // cppcheck-suppress ignoredReturnValue
-                            log("Threads did not terminate in the given time after request.");
-                            return (false);
-                        }
-                    }
-                }
-            }
+            /// signaled when threads terminate or become ready
+            std::mutex terminated_threads_mutex_;
+            std::condition_variable terminated_threads_condition_;
+            std::atomic<std::size_t> terminated_threads_waiters_;
 
+            std::atomic<bool> watchdog_started_;
+            MPMCQueue<Thread::Reference> watchdog_queue_;
 
-            bool empty()
-            {
-                const std::lock_guard<std::mutex> lock(threads_mutex_);
-                return (threads_.empty());
-            }
+            /// OS thread id -> name, only named threads, see Parameters::Name
+            std::mutex names_mutex_;
+            std::map<std::int64_t, std::string> names_;
 
 
-            void drop(const std::list<Thread>::iterator &item)
+        protected:
+            class WatchdogEntry
             {
-                const std::lock_guard<std::mutex> lock(terminated_threads_mutex_);
-                terminated_threads_.push_back(item);
-            }
-
+            public:
+                enum class Type
+                {
+                    HEARTBEAT = 0,
+                    BUDGET = 1
+                };
 
-        public:
-            using t_Logger::log;
+            public:
+                Thread::Reference reference_;
+                Type type_;
+                std::size_t timeout_ticks_;
+                std::size_t heartbeat_;     /// heartbeat only
+                std::int64_t cpu_time_ns_;  /// budget only, CPU time at the beginning of the window
+                bool demoted_;              /// budget only
+            };
 
 
-            Supervisor()
+            static std::size_t getTicks(const std::size_t ms)
             {
-                status_ = Status::UNDEFINED;
+                return (std::max<std::size_t>(
+                        1, (ms + THREAD_SUPERVISOR_WATCHDOG_TICK_MS - 1) / THREAD_SUPERVISOR_WATCHDOG_TICK_MS));
             }
 
 
-            ~Supervisor()
+            void checkHeartbeat(WatchdogEntry &expired, Thread &thread)
             {
-                if (Status::ACTIVE == status_)
+                const std::size_t heartbeat = thread.heartbeat_.load(std::memory_order_relaxed);
+                if (heartbeat == expired.heartbeat_ and not thread.heartbeat_suspended_.load(std::memory_order_relaxed))
                 {
-                    // - throwing in destructor -> terminate(), unless noexcept(false) is set.
-                    // - noexcept(false) however interferes with other stuff in derived classes.
-                    // - this check is intended to detect API misuse and should not fail under
-                    // normal conditions.
+                    // cppcheck-suppress ignoredReturnValue
+                    log("Supervisor / thread heartbeat timeout: ",
+                        expired.reference_.index_,
+                        " / ",
+                        thread.parameters_.heartbeat_.timeout_ms_,
+                        " ms");
+
+                    if (Parameters::Heartbeat::Action::TERMINATE == thread.parameters_.heartbeat_.action_)
+                    {
+                        requestShutdown(thread);
+                        notifyStopRequests();
+                        // a stalled thread may never return and apply its termination policy
+                        if (Parameters::TerminationPolicy::KILLALL == thread.parameters_.termination_policy_)
+                        {
+                            interrupt();
+                        }
+                    }
+                }
+                expired.heartbeat_ = heartbeat;
+            }
+
+
+            void checkBudget(WatchdogEntry &expired, Thread &thread)
+            {
+                const Parameters::Budget &budget = thread.parameters_.budget_;
+                bool exceeded = false;
+
+                const std::int64_t cpu_time_ns = std::max<std::int64_t>(0, thread.getCPUTime(expired.reference_));
+                if (0 != budget.cpu_ms_ and 0 != budget.window_ms_
+                    and cpu_time_ns - expired.cpu_time_ns_ > static_cast<std::int64_t>(budget.cpu_ms_) * 1000000)
+                {
+                    // cppcheck-suppress ignoredReturnValue
+                    log("Supervisor / thread exceeded CPU budget: ",
+                        expired.reference_.index_,
+                        " / ",
+                        (cpu_time_ns - expired.cpu_time_ns_) / 1000000,
+                        " ms > ",
+                        budget.cpu_ms_,
+                        " ms per ",
+                        budget.window_ms_,
+                        " ms");
+                    exceeded = true;
+                }
+                expired.cpu_time_ns_ = cpu_time_ns;
+
+                const std::size_t allocated_bytes = thread.allocated_bytes_.load(std::memory_order_relaxed);
+                if (0 != budget.memory_bytes_ and allocated_bytes > budget.memory_bytes_)
+                {
+                    // cppcheck-suppress ignoredReturnValue
+                    log("Supervisor / thread exceeded memory budget: ",
+                        expired.reference_.index_,
+                        " / ",
+                        allocated_bytes,
+                        " > ",
+                        budget.memory_bytes_,
+                        " bytes");
+                    exceeded = true;
+                }
+
+                if (not exceeded)
+                {
+                    return;
+                }
+
+                switch (budget.action_)
+                {
+                    case Parameters::Budget::Action::LOG:
+                        break;
+
+                    case Parameters::Budget::Action::DEMOTE:
+                        if (not expired.demoted_)
+                        {
+                            int result = 0;
+                            // the handle is released when the thread is joined
+                            thread.callWhileRunning(
+                                    expired.reference_,
+                                    [&thread, &result]()
+                                    {
+                                        sched_param sched_params;
+                                        sched_params.sched_priority = 0;
+                                        result = pthread_setschedparam(
+                                                thread.thread_.native_handle(), SCHED_IDLE, &sched_params);
+                                    });
+                            if (0 != result)
+                            {
+                                // cppcheck-suppress ignoredReturnValue
+                                log("Supervisor error: could not demote thread: ", expired.reference_.index_);
+                            }
+                            expired.demoted_ = true;
+                        }
+                        break;
+
+                    case Parameters::Budget::Action::TERMINATE:
+                        requestShutdown(thread);
+                        notifyStopRequests();
+                        break;
+
+                    default:
+                        // cppcheck-suppress ignoredReturnValue
+                        log("Supervisor error: unknown budget action");
+                        break;
+                }
+            }
+
+
+            /// Watchdog thread, checks heartbeats and budgets of threads registered in watchdog_queue_
+            void runWatchdog()
+            {
+                const std::chrono::milliseconds tick_ms(THREAD_SUPERVISOR_WATCHDOG_TICK_MS);
+                TimerWheel<WatchdogEntry> timers;
+
+                std::chrono::steady_clock::time_point tick_time = std::chrono::steady_clock::now();
+                while (waitUntil(tick_time += tick_ms))
+                {
+                    Thread::Reference reference;
+                    while (watchdog_queue_.pop(reference))
+                    {
+                        const Thread::Registry::Guard thread = threads_.find(reference);
+                        if (not thread)
+                        {
+                            continue;
+                        }
+
+                        if (thread->parameters_.heartbeat_.isEnabled())
+                        {
+                            WatchdogEntry entry{ reference,
+                                                 WatchdogEntry::Type::HEARTBEAT,
+                                                 getTicks(thread->parameters_.heartbeat_.timeout_ms_),
+                                                 thread->heartbeat_.load(std::memory_order_relaxed),
+                                                 0,
+                                                 false };
+                            timers.add(entry.timeout_ticks_, entry);
+                        }
+                        if (thread->parameters_.budget_.isEnabled())
+                        {
+                            WatchdogEntry entry{ reference,
+                                                 WatchdogEntry::Type::BUDGET,
+                                                 getTicks(thread->parameters_.budget_.window_ms_),
+                                                 0,
+                                                 std::max<std::int64_t>(0, thread->getCPUTime(reference)),
+                                                 false };
+                            timers.add(entry.timeout_ticks_, entry);
+                        }
+                    }
+
+                    timers.advance(
+                            [this, &timers](WatchdogEntry &expired)
+                            {
+                                const Thread::Registry::Guard thread = threads_.find(expired.reference_);
+                                if (not thread)
+                                {
+                                    return;
+                                }
+
+                                switch (expired.type_)
+                                {
+                                    case WatchdogEntry::Type::HEARTBEAT:
+                                        checkHeartbeat(expired, *thread);
+                                        break;
+                                    case WatchdogEntry::Type::BUDGET:
+                                        checkBudget(expired, *thread);
+                                        break;
+                                    default:
+                                        break;
+                                }
+                                timers.add(expired.timeout_ticks_, expired);
+                            });
+                }
+            }
+
+
+            void startWatchdog()
+            {
+                // stops on interrupt after all shutdown phases, see @ref shutdown
+                if (not watchdog_started_.exchange(true))
+                {
+                    spawnThread(
+                            nullptr,
+                            /*internal=*/true,
+                            Parameters(
+                                    Parameters::Restart(/*attempts=*/1),
+                                    Parameters::TerminationPolicy::IGNORE,
+                                    Parameters::ExceptionPolicy::CATCH),
+                            &Supervisor::runWatchdog,
+                            this);
+                }
+            }
+
+
+            void registerWatchdog(const Thread::Reference &reference)
+            {
+                startWatchdog();
+                while (not watchdog_queue_.push(reference))
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+
+        protected:
+            void notifyWaiters()
+            {
+                if (terminated_threads_waiters_ > 0)
+                {
+                    const std::lock_guard<std::mutex> lock(terminated_threads_mutex_);
+                    terminated_threads_condition_.notify_all();
+                }
+            }
+
+
+            /// Join terminated threads and release their slots
+            void reap()
+            {
+                if (threads_.reap(
+                            [this](Thread &thread)
+                            {
+                                thread.join();
+                                traceEvent(trace::Event::JOIN, thread.self_);
+                            })
+                    > 0)
+                {
+                    notifyWaiters();
+                }
+            }
+
+
+            /// Wait for termination of all threads, returns false if some threads are running after the deadline
+            bool wait(const std::chrono::steady_clock::time_point &deadline)
+            {
+                for (;;)
+                {
+                    reap();
+                    if (threads_.empty())
+                    {
+                        return (true);
+                    }
+
+                    bool terminated = false;
+                    {
+                        ++terminated_threads_waiters_;
+                        std::unique_lock<std::mutex> lock(terminated_threads_mutex_);
+                        terminated = terminated_threads_condition_.wait_until(
+                                lock,
+                                deadline,
+                                [this]() { return (threads_.hasTerminated() or threads_.empty()); });
+                        --terminated_threads_waiters_;
+                    }
+
+                    if (not terminated)
+                    {
+                        // cppcheck-suppress ignoredReturnValue
+                        log("Threads did not terminate in the given time after request.");
+                        return (false);
+                    }
+                }
+            }
+
+
+            class ShutdownEntry
+            {
+            public:
+                Thread::Reference reference_;
+                std::size_t phase_;
+                std::size_t timeout_ms_;
+                std::chrono::steady_clock::time_point deadline_;
+            };
+
+
+            /// Wait for termination of threads in parallel, each thread has its own deadline
+            void waitPhase(std::vector<ShutdownEntry> &pending, ShutdownReport &report)
+            {
+                for (;;)
+                {
+                    reap();
+
+                    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                    std::chrono::steady_clock::time_point next_deadline = std::chrono::steady_clock::time_point::max();
+                    std::size_t kept = 0;
+                    for (const ShutdownEntry &entry : pending)
+                    {
+                        if (not threads_.find(entry.reference_))
+                        {
+                            continue;
+                        }
+
+                        if (entry.deadline_ <= now)
+                        {
+                            // cppcheck-suppress ignoredReturnValue
+                            log("Supervisor / thread missed shutdown deadline: ",
+                                entry.reference_.index_,
+                                " / phase ",
+                                entry.phase_,
+                                " / ",
+                                entry.timeout_ms_,
+                                " ms");
+                            report.missed_deadlines_.push_back(
+                                    ShutdownReport::Entry{ entry.reference_, entry.phase_, entry.timeout_ms_ });
+                            continue;
+                        }
+
+                        next_deadline = std::min(next_deadline, entry.deadline_);
+                        pending[kept] = entry;
+                        ++kept;
+                    }
+                    pending.resize(kept);
+
+                    if (pending.empty())
+                    {
+                        return;
+                    }
+
+                    ++terminated_threads_waiters_;
+                    {
+                        std::unique_lock<std::mutex> lock(terminated_threads_mutex_);
+                        terminated_threads_condition_.wait_until(
+                                lock, next_deadline, [this]() { return (threads_.hasTerminated()); });
+                    }
+                    --terminated_threads_waiters_;
+                }
+            }
+
+
+            /// Record lifecycle event if supported by the logger, does nothing otherwise
+            void traceEvent(
+                    [[maybe_unused]] const trace::Event event,
+                    [[maybe_unused]] const Thread::Reference &reference)
+            {
+                if constexpr (trace::IsEnabled<t_Logger>::value)
+                {
+                    t_Logger::trace(event, reference.index_);
+                }
+            }
+
+
+            std::size_t getPlacementIndex()
+            {
+                return (placement_counter_++);
+            }
+
+
+            std::size_t getSequenceNumber()
+            {
+                return (sequence_counter_++);
+            }
+
+
+            /// Interrupt status of the group, ignores stop requests of individual threads
+            [[nodiscard]] bool isSupervisorInterrupted() const
+            {
+                return (Status::INTERRUPTED == status_.load(std::memory_order_acquire));
+            }
+
+
+            /// Request restart of threads matching the given predicate, threads without restarts are not affected
+            template <class t_Predicate>
+            void requestStop(t_Predicate &&predicate)
+            {
+                threads_.forEach(
+                        [&predicate](const Thread::Reference & /*reference*/, Thread &thread)
+                        {
+                            if (thread.restartable_.load(std::memory_order_relaxed) and predicate(thread))
+                            {
+                                thread.stop_requested_.store(true, std::memory_order_relaxed);
+                            }
+                        });
+                notifyStopRequests();
+            }
+
+
+            /// Wake up threads waiting in @ref waitUntil and in subscribed primitives, see @ref subscribe
+            void notifyStopRequests()
+            {
+                // waiters check stop requests under the lock
+                {
+                    const std::lock_guard<std::mutex> lock(interrupt_mutex_);
+                }
+                interrupt_condition_.notify_all();
+                notifyListeners();
+            }
+
+
+            void notifyListeners() const
+            {
+                const std::lock_guard<std::mutex> lock(listeners_mutex_);
+                for (InterruptListener *listener : listeners_)
+                {
+                    listener->notifyInterrupt();
+                }
+            }
+
+
+            /// Interrupt threads of this supervisor, children are not affected, see @ref interrupt
+            void interruptThreads()
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(interrupt_mutex_);
+                    status_.store(Status::INTERRUPTED, std::memory_order_release);
+                }
+                // stop tokens, threads published concurrently check the status, see @ref publish
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                threads_.forEach([](const Thread::Reference & /*reference*/, Thread &thread)
+                                 { thread.stop_requested_.store(true, std::memory_order_release); });
+                interrupt_condition_.notify_all();
+                notifyListeners();
+            }
+
+
+            /// Stop request without restart, see @ref notifyStopRequests
+            static void requestShutdown(Thread &thread)
+            {
+                thread.shutdown_requested_.store(true);
+                thread.stop_requested_.store(true);
+            }
+
+
+            /// Apply restart strategy after the given thread has ended an attempt
+            void restartGroup(const Thread &thread)
+            {
+                switch (strategy_)
+                {
+                    case Strategy::ONE_FOR_ONE:
+                        break;
+
+                    case Strategy::ONE_FOR_ALL:
+                        // cppcheck-suppress ignoredReturnValue
+                        log("Supervisor / restarting thread group: ", thread.self_.index_);
+                        requestStop([&thread](const Thread &other) { return (&thread != &other); });
+                        break;
+
+                    case Strategy::REST_FOR_ONE:
+                        // cppcheck-suppress ignoredReturnValue
+                        log("Supervisor / restarting thread group: ", thread.self_.index_);
+                        requestStop([&thread](const Thread &other) { return (other.sequence_ > thread.sequence_); });
+                        break;
+
+                    default:
+                        // cppcheck-suppress ignoredReturnValue
+                        log("Supervisor error: unknown restart strategy");
+                        break;
+                }
+            }
+
+
+            bool empty()
+            {
+                reap();
+                return (threads_.empty());
+            }
+
+
+            void setThreadName(const std::int64_t tid, const std::string &name)
+            {
+                const std::lock_guard<std::mutex> lock(names_mutex_);
+                names_[tid] = name;
+            }
+
+
+            /// Called by Thread::start() when the thread slot is initialized, see Registry::publish()
+            void publish(Thread &thread)
+            {
+                threads_.publish(thread.self_);
+                // pairs with the fence in @ref interrupt: either it sees the slot, or we see its status
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (isSupervisorInterrupted())
+                {
+                    thread.stop_requested_.store(true, std::memory_order_release);
+                }
+            }
+
+
+            /// Called by a thread as the last action
+            void drop(const Thread::Reference &item)
+            {
+                const Thread::Registry::Guard thread = threads_.find(item);
+                if (thread and thread->parameters_.name_.isEnabled())
+                {
+                    // thread ids are reused by the OS
+                    const std::lock_guard<std::mutex> lock(names_mutex_);
+                    names_.erase(thread->metrics_.getTid());
+                }
+
+                traceEvent(trace::Event::DROP, item);
+                threads_.terminate(item);
+                notifyWaiters();
+            }
+
+
+            /**
+             * See @ref spawn, the thread waits at the given barrier before
+             * calling its function if it is not null, internal threads are
+             * not visible to users, see Thread::internal_.
+             */
+            template <class... t_Args>
+            Thread::Reference spawnThread(
+                    const std::shared_ptr<StartBarrier> &barrier,
+                    const bool internal,
+                    t_Args &&...args)
+            {
+                if (isSupervisorInterrupted())
+                {
+                    // e.g., a thread adding threads races with shutdown
+                    // cppcheck-suppress ignoredReturnValue
+                    log("Addition of a thread attempted after interrupt.");
+                    return (Thread::Reference());
+                }
+                else
+                {
+                    // status is written only once to avoid invalidation of the cache line polled by threads
+                    Status status = status_.load(std::memory_order_relaxed);
+                    if (Status::UNDEFINED == status)
+                    {
+                        status_.compare_exchange_strong(status, Status::ACTIVE, std::memory_order_release);
+                    }
+
+                    // recycle slots of terminated threads
+                    reap();
+
+                    const Thread::Reference reference = threads_.acquire();
+                    if (not reference.isValid())
+                    {
+                        // cppcheck-suppress ignoredReturnValue
+                        log("Supervisor error: maximal number of threads is reached.");
+                        return (Thread::Reference());
+                    }
+                    Thread &thread = threads_.get(reference);
+                    thread.barrier_ = barrier;
+                    thread.internal_ = internal;
+                    if (not thread.start(this, reference, std::forward<t_Args>(args)...))
+                    {
+                        return (Thread::Reference());
+                    }
+                    if (thread.parameters_.heartbeat_.isEnabled() or thread.parameters_.budget_.isEnabled())
+                    {
+                        registerWatchdog(reference);
+                    }
+                    return (reference);
+                }
+            }
+
+
+        public:
+            /**
+             * Coordinated start of a group of threads, e.g., pipeline stages:
+             * threads are added as usual, but wait until all of them are
+             * initialized and @ref start is called, so that producers do not
+             * run ahead of their consumers. The batch is started on
+             * destruction if @ref start was not called. Threads that are
+             * stopped before the batch is started do not call their
+             * functions.
+             */
+            class Batch
+            {
+                THREAD_SUPERVISOR_DISABLE_CLASS_COPY(Batch)
+
+            protected:
+                Supervisor &supervisor_;
+                std::shared_ptr<StartBarrier> barrier_;
+                std::size_t size_;
+                bool complete_;
+
+            public:
+                explicit Batch(Supervisor &supervisor)
+                  : supervisor_(supervisor), barrier_(std::make_shared<StartBarrier>())
+                {
+                    size_ = 0;
+                    complete_ = true;
+                    supervisor_.subscribe(*barrier_);
+                }
+
+                ~Batch()
+                {
+                    start();
+                }
+
+                /// Same as Supervisor::spawn()
+                template <class... t_Args>
+                Thread::Reference add(t_Args &&...args)
+                {
+                    const Thread::Reference reference =
+                            supervisor_.spawnThread(barrier_, /*internal=*/false, std::forward<t_Args>(args)...);
+                    if (reference.isValid())
+                    {
+                        ++size_;
+                    }
+                    else
+                    {
+                        complete_ = false;
+                    }
+                    return (reference);
+                }
+
+                /**
+                 * Release threads of the batch when all of them are
+                 * initialized, does not block.
+                 * @return false if some threads were not added.
+                 */
+                bool start()
+                {
+                    if (nullptr != barrier_)
+                    {
+                        // the open barrier does not wait for interrupts
+                        supervisor_.unsubscribe(*barrier_);
+                        barrier_->release(size_);
+                        barrier_ = nullptr;
+                    }
+                    return (complete_);
+                }
+            };
+
+
+        public:
+            using t_Logger::log;
+
+
+            Supervisor() : Supervisor(Strategy::ONE_FOR_ONE)
+            {
+            }
+
+
+            /**
+             * @param[in] strategy restart strategy of the group
+             * @param[in] parent parent supervisor, which must outlive this one, nullptr for a root supervisor
+             */
+            explicit Supervisor(const Strategy strategy, Supervisor *parent = nullptr)
+              : strategy_(strategy), parent_(parent), watchdog_queue_(THREAD_SUPERVISOR_WATCHDOG_QUEUE_SIZE)
+            {
+                watchdog_started_ = false;
+                status_ = Status::UNDEFINED;
+                placement_counter_ = 0;
+                sequence_counter_ = 0;
+                terminated_threads_waiters_ = 0;
+
+                if (nullptr != parent_)
+                {
+                    const std::lock_guard<std::mutex> lock(parent_->children_mutex_);
+                    parent_->children_.push_back(this);
+                    if (parent_->isSupervisorInterrupted())
+                    {
+                        status_ = Status::INTERRUPTED;
+                    }
+                }
+            }
+
+
+            ~Supervisor()
+            {
+                if (nullptr != parent_)
+                {
+                    const std::lock_guard<std::mutex> lock(parent_->children_mutex_);
+                    parent_->children_.erase(std::find(parent_->children_.begin(), parent_->children_.end(), this));
+                }
+
+                if (Status::ACTIVE == status_)
+                {
+                    // - throwing in destructor -> terminate(), unless noexcept(false) is set.
+                    // - noexcept(false) however interferes with other stuff in derived classes.
+                    // - this check is intended to detect API misuse and should not fail under
+                    // normal conditions.
                     // cppcheck-suppress ignoredReturnValue
                     log("Destructor of Supervisor is reached with active status,"
                         "which means that interrupt() method has not been called.");
@@ -450,45 +2203,366 @@ namespace tut
             }
 
 
-            /// Interrupt execution, see @ref isInterrupted
+            /**
+             * Notify the listener on @ref interrupt and on stop requests of
+             * threads, so that blocking primitives need not poll interrupts.
+             * The listener must be unsubscribed before it is destroyed.
+             */
+            void subscribe(InterruptListener &listener) const
+            {
+                const std::lock_guard<std::mutex> lock(listeners_mutex_);
+                listeners_.push_back(&listener);
+            }
+
+
+            /// See @ref subscribe, returns after the listener has been notified if notification is in progress
+            void unsubscribe(InterruptListener &listener) const
+            {
+                const std::lock_guard<std::mutex> lock(listeners_mutex_);
+                listeners_.erase(std::find(listeners_.begin(), listeners_.end(), &listener));
+            }
+
+
+            /// Interrupt execution of this supervisor and its children, see @ref isInterrupted
             void interrupt()
             {
-                status_ = Status::INTERRUPTED;
+                interruptThreads();
+
+                const std::lock_guard<std::mutex> lock(children_mutex_);
+                for (Supervisor *child : children_)
+                {
+                    child->interrupt();
+                }
             }
 
 
-            /// Check if interrupted, child threads should stop when true (pass supervisor as a parameter).
+            /**
+             * Check if interrupted, child threads should stop when true (pass supervisor as a parameter).
+             * When called by a supervised thread, also returns true if the thread is requested to restart
+             * by its group.
+             */
             [[nodiscard]] bool isInterrupted() const
             {
-                return (Status::INTERRUPTED == status_);
+                if (isSupervisorInterrupted())
+                {
+                    return (true);
+                }
+                const Thread *thread = Thread::getCurrent();
+                return (nullptr != thread and thread->stop_requested_.load(std::memory_order_relaxed));
+            }
+
+
+            /// Stop token of the calling thread, must be called by a supervised thread
+            [[nodiscard]] StopToken getStopToken() const
+            {
+                const Thread *thread = Thread::getCurrent();
+                if (nullptr == thread)
+                {
+                    // cppcheck-suppress ignoredReturnValue
+                    log("Stop token requested by a thread that is not supervised.");
+                    std::terminate();
+                }
+                return (StopToken(&thread->stop_requested_));
+            }
+
+
+            /**
+             * Memory resource of the calling thread, see Parameters::Arena and
+             * Parameters::Budget, the default resource if neither is enabled
+             * or the thread is not supervised. Memory allocated from the arena must not be used
+             * after the thread function returns.
+             */
+            [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const
+            {
+                const Thread *thread = Thread::getCurrent();
+                if (nullptr == thread or nullptr == thread->memory_resource_)
+                {
+                    return (std::pmr::get_default_resource());
+                }
+                return (thread->memory_resource_);
+            }
+
+
+            /// Restart all threads of this supervisor and its children, which have restarts enabled
+            void restart()
+            {
+                requestStop([](const Thread & /*thread*/) { return (true); });
+
+                const std::lock_guard<std::mutex> lock(children_mutex_);
+                for (Supervisor *child : children_)
+                {
+                    child->restart();
+                }
             }
 
 
-            /// Interrupt and wait for children to stop
+            /**
+             * Sleep until the given time point, wake up immediately on @ref interrupt.
+             * @return false if interrupted.
+             */
+            template <class t_Clock, class t_Duration>
+            bool waitUntil(const std::chrono::time_point<t_Clock, t_Duration> &time_point) const
+            {
+                std::unique_lock<std::mutex> lock(interrupt_mutex_);
+                return (not interrupt_condition_.wait_until(lock, time_point, [this]() { return (isInterrupted()); }));
+            }
+
+
+            /// Sleep for the given duration, see @ref waitUntil
+            template <class t_Rep, class t_Period>
+            bool sleepFor(const std::chrono::duration<t_Rep, t_Period> &duration) const
+            {
+                return (waitUntil(std::chrono::steady_clock::now() + duration));
+            }
+
+
+            /**
+             * Report that the calling thread is alive, must be called more often than
+             * Parameters::Heartbeat::timeout_ms_, otherwise the watchdog reports a stall.
+             * Does nothing if called from a thread that is not supervised.
+             */
+            void heartbeat() const
+            {
+                Thread *thread = Thread::getCurrent();
+                if (nullptr != thread)
+                {
+                    thread->heartbeat();
+                }
+            }
+
+
+            /// Snapshot of runtime metrics of all threads, threads are not stopped
+            std::vector<Metrics> getMetrics()
+            {
+                std::vector<Metrics> metrics;
+                metrics.reserve(threads_.size());
+                threads_.forEach(
+                        [&metrics](const Thread::Reference &reference, const Thread &thread)
+                        {
+                            if (thread.internal_)
+                            {
+                                return;
+                            }
+                            metrics.push_back(thread.getMetrics(reference));
+                            metrics.back().allocated_bytes_ = thread.allocated_bytes_.load(std::memory_order_relaxed);
+                        });
+
+                const std::lock_guard<std::mutex> lock(names_mutex_);
+                for (Metrics &thread_metrics : metrics)
+                {
+                    const std::map<std::int64_t, std::string>::const_iterator name = names_.find(thread_metrics.tid_);
+                    if (names_.end() != name)
+                    {
+                        thread_metrics.name_ = name->second;
+                    }
+                }
+                return (metrics);
+            }
+
+
+            /**
+             * OS thread ids and names of running named threads, see
+             * Parameters::Name, can be used to correlate logs, metrics, and
+             * profiler samples.
+             */
+            std::map<std::int64_t, std::string> getThreadNames()
+            {
+                const std::lock_guard<std::mutex> lock(names_mutex_);
+                return (names_);
+            }
+
+
+            /// Last intercepted exceptions of threads that have not been joined yet, see Parameters::ExceptionHandler
+            std::vector<CrashReport> getCrashReports()
+            {
+                std::vector<CrashReport> reports;
+                threads_.forEach(
+                        [&reports](const Thread::Reference & /*reference*/, const Thread &thread)
+                        {
+                            if (thread.internal_)
+                            {
+                                return;
+                            }
+                            const std::lock_guard<std::mutex> lock(thread.crash_report_mutex_);
+                            if (nullptr != thread.crash_report_.exception_)
+                            {
+                                reports.push_back(thread.crash_report_);
+                            }
+                        });
+                return (reports);
+            }
+
+
+            /**
+             * Graceful shutdown: threads are stopped in phases according to
+             * Parameters::Shutdown. Threads of a phase are requested to stop
+             * simultaneously and the next phase starts when they have
+             * terminated or missed their deadlines. Afterwards the supervisor
+             * is interrupted, and children are shut down.
+             *
+             * @param[in] wait_ms time limit of the whole shutdown including children, also the default timeout of
+             * a phase; deadlines of threads are cut to the time remaining until this limit
+             */
+            ShutdownReport shutdown(const std::size_t wait_ms = 10000)
+            {
+                return (shutdown(std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_ms), wait_ms));
+            }
+
+
+        protected:
+            /// See @ref shutdown, all waits end at the given deadline
+            ShutdownReport shutdown(const std::chrono::steady_clock::time_point &deadline, const std::size_t wait_ms)
+            {
+                ShutdownReport report;
+
+                std::vector<ShutdownEntry> entries;
+                entries.reserve(threads_.size());
+                threads_.forEach(
+                        [&entries, wait_ms](const Thread::Reference &reference, const Thread &thread)
+                        {
+                            // internal threads stop on interrupt below
+                            if (thread.internal_)
+                            {
+                                return;
+                            }
+                            const std::size_t timeout_ms = (0 == thread.parameters_.shutdown_.timeout_ms_)
+                                                                   ? wait_ms
+                                                                   : thread.parameters_.shutdown_.timeout_ms_;
+                            entries.push_back(ShutdownEntry{
+                                    reference, thread.parameters_.shutdown_.phase_, timeout_ms, {} });
+                        });
+                std::stable_sort(
+                        entries.begin(),
+                        entries.end(),
+                        [](const ShutdownEntry &left, const ShutdownEntry &right)
+                        { return (left.phase_ < right.phase_); });
+
+                std::vector<ShutdownEntry> pending;
+                pending.reserve(entries.size());
+                for (std::size_t phase_begin = 0; phase_begin < entries.size();)
+                {
+                    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+                    pending.clear();
+                    std::size_t phase_end = phase_begin;
+                    for (; phase_end < entries.size() and entries[phase_end].phase_ == entries[phase_begin].phase_;
+                         ++phase_end)
+                    {
+                        const Thread::Registry::Guard thread = threads_.find(entries[phase_end].reference_);
+                        if (thread)
+                        {
+                            requestShutdown(*thread);
+
+                            pending.push_back(entries[phase_end]);
+                            pending.back().deadline_ =
+                                    std::min(now + std::chrono::milliseconds(pending.back().timeout_ms_), deadline);
+                        }
+                    }
+                    notifyStopRequests();
+
+                    waitPhase(pending, report);
+                    phase_begin = phase_end;
+                }
+
+                // children are interrupted by their own shutdown after their phases
+                interruptThreads();
+                {
+                    const std::lock_guard<std::mutex> lock(children_mutex_);
+                    for (Supervisor *child : children_)
+                    {
+                        ShutdownReport child_report = child->shutdown(deadline, wait_ms);
+                        report.missed_deadlines_.insert(
+                                report.missed_deadlines_.end(),
+                                child_report.missed_deadlines_.begin(),
+                                child_report.missed_deadlines_.end());
+                        report.complete_ = report.complete_ and child_report.complete_;
+                    }
+                }
+                report.complete_ = wait(deadline) and report.complete_;
+
+                return (report);
+            }
+
+
+        public:
+            /// Graceful shutdown, returns false if some threads missed their deadlines, see @ref shutdown
             bool stop(const std::size_t wait_ms = 10000)
             {
-                interrupt();
-                return (wait(wait_ms));
+                return (shutdown(wait_ms).isOk());
             }
 
 
-            /// Add a thread: (<thread parameters>, <function pointer>, <function parameters>)
+            /**
+             * Add a thread: (<thread parameters>, <function pointer>, <function parameters>).
+             * Scheduling parameters are applied by the thread before calling the function.
+             * @return false if scheduling parameters could not be applied and failures are not ignored, the function
+             * is not executed in this case; false if the supervisor is interrupted, the thread is not started.
+             */
             template <class... t_Args>
-            void add(t_Args &&...args)
+            bool add(t_Args &&...args)
             {
-                if (isInterrupted())
+                return (spawn(std::forward<t_Args>(args)...).isValid());
+            }
+
+
+            /// Same as @ref add, but returns reference of the thread, the reference is invalid on failure
+            template <class... t_Args>
+            Thread::Reference spawn(t_Args &&...args)
+            {
+                return (spawnThread(nullptr, /*internal=*/false, std::forward<t_Args>(args)...));
+            }
+
+
+            /**
+             * Wait until the thread is initialized and is about to call its
+             * function, i.e., scheduling parameters are applied, and the
+             * arena is allocated, see Parameters.
+             * @return false on timeout or if the thread has terminated.
+             */
+            bool waitReady(const Thread::Reference &reference, const std::size_t wait_ms = 10000)
+            {
+                reap();
+
+                const auto is_ready = [this, &reference]()
                 {
-                    // cppcheck-suppress ignoredReturnValue
-                    log("Addition of a thread attempted after interrupt.");
-                    std::terminate();
+                    const Thread::Registry::Guard thread = threads_.find(reference);
+                    return (not thread or thread->ready_.load());
+                };
+
+                {
+                    ++terminated_threads_waiters_;
+                    std::unique_lock<std::mutex> lock(terminated_threads_mutex_);
+                    terminated_threads_condition_.wait_for(lock, std::chrono::milliseconds(wait_ms), is_ready);
+                    --terminated_threads_waiters_;
                 }
-                else
+
+                const Thread::Registry::Guard thread = threads_.find(reference);
+                return (thread and thread->ready_.load());
+            }
+
+
+            /// Returns false if the thread has terminated
+            [[nodiscard]] bool isRunning(const Thread::Reference &reference)
+            {
+                reap();
+                return (static_cast<bool>(threads_.find(reference)));
+            }
+
+
+            /**
+             * Request a single thread to stop without restart, other threads
+             * are not affected. Returns false if the thread has terminated.
+             */
+            bool retire(const Thread::Reference &reference)
+            {
+                const Thread::Registry::Guard thread = threads_.find(reference);
+                if (not thread)
                 {
-                    status_ = Status::ACTIVE;
-                    const std::lock_guard<std::mutex> lock(threads_mutex_);
-                    threads_.emplace_back();
-                    threads_.back().start(this, --threads_.end(), std::forward<t_Args>(args)...);
+                    return (false);
                 }
+                requestShutdown(*thread);
+                notifyStopRequests();
+                return (true);
             }
         };
 
@@ -528,9 +2602,9 @@ namespace tut
 
             /// Add a thread: (<thread parameters>, <function pointer>, <this>, <function parameters>)
             template <class... t_Args>
-            void addSupervisedThread(t_Args &&...args)
+            bool addSupervisedThread(t_Args &&...args)
             {
-                getThreadSupervisor().add(std::forward<t_Args>(args)...);
+                return (getThreadSupervisor().add(std::forward<t_Args>(args)...));
             }
 
 
@@ -0,0 +1,394 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Lightweight supervised tasks multiplexed over carrier threads.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "supervisor.h"
+
+
+namespace tut
+{
+    namespace thread
+    {
+        /// Result of a task step, tells the carrier when to call the task again, see TaskPool
+        class TaskStep
+        {
+        public:
+            enum class Type
+            {
+                YIELD,  /// call again after other ready tasks
+                SLEEP,  /// call again after a delay
+                DONE    /// equivalent to return from a thread function
+            };
+
+        public:
+            Type type_;
+            std::chrono::steady_clock::duration delay_;
+
+        public:
+            static TaskStep yield()
+            {
+                return (TaskStep{ Type::YIELD, std::chrono::steady_clock::duration::zero() });
+            }
+
+            template <class t_Rep, class t_Period>
+            static TaskStep sleepFor(const std::chrono::duration<t_Rep, t_Period> &duration)
+            {
+                return (TaskStep{
+                        Type::SLEEP, std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration) });
+            }
+
+            static TaskStep done()
+            {
+                return (TaskStep{ Type::DONE, std::chrono::steady_clock::duration::zero() });
+            }
+        };
+
+
+
+        /**
+         * Runs many supervised tasks on a small number of supervised carrier
+         * threads, e.g., I/O polling loops that mostly sleep. A task is a
+         * function returning TaskStep: instead of blocking it performs a
+         * single step and returns, the carrier calls it again according to
+         * the returned value. Task state must be kept in its arguments.
+         * C++20 coroutines are not supported, since the library targets
+         * C++17: a coroutine can be driven by a step function that resumes
+         * it and translates its suspension points to TaskStep values.
+         *
+         * Tasks follow thread semantics of Parameters: the function is
+         * called again after a delay according to Parameters::Restart when
+         * a step throws or returns TaskStep::done(); exceptions are handled
+         * according to Parameters::ExceptionPolicy, with ExceptionPolicy::PASS
+         * the exception is passed to the carrier thread and the task is
+         * dropped; TerminationPolicy::KILLALL interrupts the pool. Scheduling,
+         * heartbeat, period, exception handler, and other thread parameters
+         * are ignored: intercepted exceptions of tasks are only logged, they
+         * are not recorded in Supervisor::getCrashReports().
+         *
+         * Tasks are cancelled when the pool supervisor is interrupted, see
+         * @ref getSupervisor, steps in progress are not preempted. Idle
+         * carriers sleep until the next task is due or the supervisor is
+         * interrupted.
+         */
+        template <class t_Logger = log::StdErr>
+        class TaskPool : protected InterruptListener
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(TaskPool)
+
+        protected:
+            class Task
+            {
+            public:
+                Parameters parameters_;
+                std::function<TaskStep()> step_;
+
+                std::size_t attempt_ = 0;
+                std::vector<std::chrono::steady_clock::time_point> restart_history_;
+                std::minstd_rand random_generator_;
+            };
+
+
+            class Entry
+            {
+            public:
+                std::chrono::steady_clock::time_point time_;
+                std::size_t sequence_;  /// FIFO order of tasks with the same time
+                std::unique_ptr<Task> task_;
+
+            public:
+                /// Heap comparison, the earliest entry is on top
+                bool operator<(const Entry &other) const
+                {
+                    return (time_ > other.time_ or (time_ == other.time_ and sequence_ > other.sequence_));
+                }
+            };
+
+
+        protected:
+            std::mutex mutex_;
+            std::condition_variable condition_;
+            std::vector<Entry> queue_;  /// heap
+            std::size_t sequence_counter_;
+
+            std::atomic<std::size_t> size_;
+
+            Supervisor<t_Logger> supervisor_;
+
+
+        protected:
+            void push(const std::chrono::steady_clock::time_point &time, std::unique_ptr<Task> task)
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                queue_.push_back(Entry{ time, sequence_counter_++, std::move(task) });
+                std::push_heap(queue_.begin(), queue_.end());
+            }
+
+
+            /// Returns the next time the task must be called, time_point::max() if the task is terminated
+            std::chrono::steady_clock::time_point step(Task &task)
+            {
+                TaskStep result = TaskStep::done();
+
+                switch (task.parameters_.exception_policy_)
+                {
+                    case Parameters::ExceptionPolicy::PASS:
+                        result = task.step_();
+                        break;
+
+                    case Parameters::ExceptionPolicy::CATCH:
+                        try
+                        {
+                            result = task.step_();
+                        }
+                        catch (const std::exception &e)
+                        {
+                            supervisor_.log("Supervisor / intercepted task exception: ", e.what());
+                        }
+                        catch (abi::__forced_unwind &)
+                        {
+                            throw;
+                        }
+                        catch (...)
+                        {
+                            supervisor_.log(
+                                    "Supervisor / intercepted task exception: ",
+                                    MetricsCounters::demangle(abi::__cxa_current_exception_type()));
+                        }
+                        break;
+
+                    default:
+                        supervisor_.log("Supervisor error: unknown exception handling type");
+                        break;
+                }
+
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                switch (result.type_)
+                {
+                    case TaskStep::Type::YIELD:
+                        return (now);
+
+                    case TaskStep::Type::SLEEP:
+                        return (now + result.delay_);
+
+                    case TaskStep::Type::DONE:
+                        break;
+
+                    default:
+                        supervisor_.log("Supervisor error: unknown task step type");
+                        break;
+                }
+
+                const Parameters::Restart &restart = task.parameters_.restart_;
+                ++task.attempt_;
+                if (not restart.isOk(task.attempt_))
+                {
+                    return (std::chrono::steady_clock::time_point::max());
+                }
+                if (not restart.circuit_breaker_.check(task.restart_history_, task.attempt_ - 1))
+                {
+                    supervisor_.log(
+                            "Supervisor / restart limit exceeded: ",
+                            restart.circuit_breaker_.max_restarts_,
+                            " restarts per ",
+                            restart.circuit_breaker_.window_ms_,
+                            " ms");
+                    return (std::chrono::steady_clock::time_point::max());
+                }
+
+                supervisor_.log(
+                        "Supervisor / restarting task: ",
+                        task.attempt_ + 1,
+                        " / ",
+                        restart.isUnlimited() ? 0 : restart.attempts_);
+                return (now + restart.getDelay(task.attempt_, task.random_generator_));
+            }
+
+
+            void terminate(const Task &task)
+            {
+                --size_;
+                switch (task.parameters_.termination_policy_)
+                {
+                    case Parameters::TerminationPolicy::KILLALL:
+                        interrupt();
+                        break;
+
+                    case Parameters::TerminationPolicy::IGNORE:
+                        break;
+
+                    default:
+                        supervisor_.log("Supervisor error: unknown termination handling type");
+                        break;
+                }
+            }
+
+
+            /// Carrier thread
+            void run()
+            {
+                for (;;)
+                {
+                    std::unique_ptr<Task> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+
+                        // checked under the lock, see @ref notifyInterrupt
+                        if (supervisor_.isInterrupted())
+                        {
+                            return;
+                        }
+
+                        if (queue_.empty())
+                        {
+                            condition_.wait(lock);
+                            continue;
+                        }
+                        if (queue_.front().time_ > std::chrono::steady_clock::now())
+                        {
+                            // a carrier that pushes an earlier task picks it up itself
+                            condition_.wait_until(lock, queue_.front().time_);
+                            continue;
+                        }
+
+                        std::pop_heap(queue_.begin(), queue_.end());
+                        task = std::move(queue_.back().task_);
+                        queue_.pop_back();
+                    }
+
+                    std::chrono::steady_clock::time_point time;
+                    try
+                    {
+                        time = step(*task);
+                    }
+                    catch (...)
+                    {
+                        // ExceptionPolicy::PASS, the task is dropped
+                        terminate(*task);
+                        throw;
+                    }
+
+                    if (std::chrono::steady_clock::time_point::max() == time)
+                    {
+                        terminate(*task);
+                    }
+                    else
+                    {
+                        push(time, std::move(task));
+                    }
+                }
+            }
+
+
+            /// Wake up idle carriers, see Supervisor::subscribe()
+            void notifyInterrupt() override
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                condition_.notify_all();
+            }
+
+
+        public:
+            /**
+             * @param[in] carriers_number number of carrier threads
+             * @param[in] parameters parameters of carrier threads
+             * @param[in] parent parent supervisor, see Supervisor
+             */
+            explicit TaskPool(
+                    const std::size_t carriers_number,
+                    const Parameters &parameters = Parameters(),
+                    Supervisor<t_Logger> *parent = nullptr)
+              : supervisor_(Supervisor<t_Logger>::Strategy::ONE_FOR_ONE, parent)
+            {
+                sequence_counter_ = 0;
+                size_ = 0;
+
+                supervisor_.subscribe(*this);
+
+                for (std::size_t i = 0; i < carriers_number; ++i)
+                {
+                    supervisor_.add(Parameters(parameters), &TaskPool::run, this);
+                }
+            }
+
+
+            ~TaskPool()
+            {
+                stop();
+                supervisor_.unsubscribe(*this);
+            }
+
+
+            /// Cancel all tasks and stop carrier threads
+            void interrupt()
+            {
+                supervisor_.interrupt();
+            }
+
+
+            bool stop(const std::size_t wait_ms = 10000)
+            {
+                interrupt();
+                return (supervisor_.stop(wait_ms));
+            }
+
+
+            /// Tasks may check interrupts of this supervisor
+            [[nodiscard]] Supervisor<t_Logger> &getSupervisor()
+            {
+                return (supervisor_);
+            }
+
+
+            /// Number of tasks that have not terminated
+            [[nodiscard]] std::size_t size() const
+            {
+                return (size_.load());
+            }
+
+
+            /**
+             * Add a task: (<task parameters>, <function pointer>, <function
+             * parameters>), the function must return TaskStep, arguments are
+             * passed as lvalues. Returns false if the pool is interrupted.
+             */
+            template <class t_Function, class... t_Args>
+            bool add(const Parameters &parameters, t_Function &&function, t_Args &&...args)
+            {
+                if (supervisor_.isInterrupted())
+                {
+                    return (false);
+                }
+
+                std::unique_ptr<Task> task = std::make_unique<Task>();
+                task->parameters_ = parameters;
+                task->step_ = [arguments = std::make_tuple(
+                                       std::forward<t_Function>(function), std::forward<t_Args>(args)...)]() mutable
+                { return (std::apply([](auto &...items) { return (std::invoke(items...)); }, arguments)); };
+                task->random_generator_.seed(
+                        static_cast<std::minstd_rand::result_type>(std::hash<const Task *>()(task.get())));
+
+                ++size_;
+                push(std::chrono::steady_clock::now(), std::move(task));
+                condition_.notify_one();
+                return (true);
+            }
+        };
+    }  // namespace thread
+}  // namespace tut
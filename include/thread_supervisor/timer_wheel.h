@@ -0,0 +1,98 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Hashed timer wheel.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace tut
+{
+    namespace thread
+    {
+        /**
+         * Hashed timer wheel: timers are stored in buckets indexed by their
+         * expiration tick modulo the number of buckets, advancing by one tick
+         * processes a single bucket. Not thread safe.
+         */
+        template <class t_Entry>
+        class TimerWheel
+        {
+        protected:
+            class Timer
+            {
+            public:
+                std::size_t expiration_tick_;
+                t_Entry entry_;
+            };
+
+
+        protected:
+            std::vector<std::vector<Timer>> buckets_;
+            std::vector<Timer> expired_;
+            std::size_t tick_;
+
+
+        public:
+            explicit TimerWheel(const std::size_t buckets_number = 256) : buckets_(buckets_number)
+            {
+                tick_ = 0;
+            }
+
+
+            [[nodiscard]] std::size_t getTick() const
+            {
+                return (tick_);
+            }
+
+
+            /// Add a timer which expires after the given number of ticks (at least one)
+            void add(const std::size_t delay_ticks, t_Entry entry)
+            {
+                const std::size_t expiration_tick = tick_ + (delay_ticks > 0 ? delay_ticks : 1);
+                buckets_[expiration_tick % buckets_.size()].push_back(Timer{ expiration_tick, std::move(entry) });
+            }
+
+
+            /// Advance by one tick and call the given function for expired timers, it is allowed to add timers
+            template <class t_Function>
+            void advance(t_Function &&function)
+            {
+                ++tick_;
+
+                std::vector<Timer> &bucket = buckets_[tick_ % buckets_.size()];
+                expired_.clear();
+
+                std::size_t kept = 0;
+                for (Timer &timer : bucket)
+                {
+                    if (timer.expiration_tick_ <= tick_)
+                    {
+                        expired_.push_back(std::move(timer));
+                    }
+                    else
+                    {
+                        if (&bucket[kept] != &timer)
+                        {
+                            bucket[kept] = std::move(timer);
+                        }
+                        ++kept;
+                    }
+                }
+                bucket.erase(bucket.begin() + static_cast<std::ptrdiff_t>(kept), bucket.end());
+
+                for (Timer &timer : expired_)
+                {
+                    function(timer.entry_);
+                }
+            }
+        };
+    }  // namespace thread
+}  // namespace tut
@@ -0,0 +1,272 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Lifecycle event tracing in Chrome trace format.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "supervisor.h"
+
+
+namespace tut
+{
+    namespace trace
+    {
+        /**
+         * Logger policy, which records thread lifecycle events into
+         * per-thread ring buffers and dumps them in Chrome trace JSON format,
+         * which can be viewed with chrome://tracing or Perfetto. Logging is
+         * forwarded to t_Logger. Usage: Supervisor<trace::Chrome<>>.
+         *
+         * Recording does not lock or allocate, except for the first event of
+         * each thread. When a buffer is full the oldest events are
+         * overwritten. Buffers of exited threads are reused by new threads,
+         * so the number of buffers is bounded by the maximal number of
+         * concurrently tracing threads, events of exited threads are kept
+         * until they are overwritten.
+         */
+        template <class t_Logger = log::StdErr, std::size_t t_events_per_thread = 4096>
+        class Chrome : public t_Logger
+        {
+        protected:
+            class Record
+            {
+            public:
+                std::int64_t time_ns_;
+                std::int64_t tid_;
+                std::uint32_t thread_index_;
+                Event event_;
+            };
+
+
+            /// Written only by the owning thread, reused after the owner exits
+            class Ring
+            {
+            public:
+                std::int64_t tid_ = 0;  /// current owner
+                std::size_t size_ = 0;
+                std::array<Record, t_events_per_thread> records_;
+            };
+
+
+            /// Shared with threads, which may exit after the logger is destroyed
+            class Rings
+            {
+            public:
+                std::mutex mutex_;
+                std::vector<std::unique_ptr<Ring>> rings_;
+                std::vector<Ring *> free_rings_;
+            };
+
+
+            /// Ring of the calling thread, returned to the free list on thread exit
+            class Holder
+            {
+            public:
+                std::uint64_t owner_id_ = 0;
+                std::weak_ptr<Rings> rings_;
+                Ring *ring_ = nullptr;
+
+            public:
+                ~Holder()
+                {
+                    release();
+                }
+
+                void release()
+                {
+                    const std::shared_ptr<Rings> rings = rings_.lock();
+                    if (nullptr != rings and nullptr != ring_)
+                    {
+                        const std::lock_guard<std::mutex> lock(rings->mutex_);
+                        rings->free_rings_.push_back(ring_);
+                    }
+                    ring_ = nullptr;
+                    rings_.reset();
+                }
+            };
+
+
+        protected:
+            const std::uint64_t id_;
+            const std::shared_ptr<Rings> rings_;
+
+
+        protected:
+            static std::uint64_t getNextId()
+            {
+                static std::atomic<std::uint64_t> counter(0);
+                return (++counter);
+            }
+
+
+            static std::int64_t getTid()
+            {
+                return (static_cast<std::int64_t>(syscall(SYS_gettid)));
+            }
+
+
+            Ring &getRing()
+            {
+                thread_local Holder holder;
+
+                // ids are used instead of addresses, since addresses may be reused
+                if (id_ != holder.owner_id_)
+                {
+                    holder.release();
+
+                    const std::lock_guard<std::mutex> lock(rings_->mutex_);
+                    if (rings_->free_rings_.empty())
+                    {
+                        rings_->rings_.push_back(std::make_unique<Ring>());
+                        holder.ring_ = rings_->rings_.back().get();
+                    }
+                    else
+                    {
+                        holder.ring_ = rings_->free_rings_.back();
+                        rings_->free_rings_.pop_back();
+                    }
+                    holder.ring_->tid_ = getTid();
+                    holder.rings_ = rings_;
+                    holder.owner_id_ = id_;
+                }
+
+                return (*holder.ring_);
+            }
+
+
+            static const char *getName(const Event event)
+            {
+                switch (event)
+                {
+                    case Event::START:
+                        return ("start");
+                    case Event::ATTEMPT_BEGIN:
+                    case Event::ATTEMPT_END:
+                        return ("attempt");
+                    case Event::EXCEPTION:
+                        return ("exception");
+                    case Event::BACKOFF_BEGIN:
+                    case Event::BACKOFF_END:
+                        return ("backoff");
+                    case Event::DROP:
+                        return ("drop");
+                    case Event::JOIN:
+                        return ("join");
+                    default:
+                        return ("unknown");
+                }
+            }
+
+
+            /// Chrome event phase: duration begin / end or instant
+            static char getPhase(const Event event)
+            {
+                switch (event)
+                {
+                    case Event::ATTEMPT_BEGIN:
+                    case Event::BACKOFF_BEGIN:
+                        return ('B');
+                    case Event::ATTEMPT_END:
+                    case Event::BACKOFF_END:
+                        return ('E');
+                    default:
+                        return ('i');
+                }
+            }
+
+
+        public:
+            Chrome() : id_(getNextId()), rings_(std::make_shared<Rings>())
+            {
+            }
+
+
+            /// Number of allocated ring buffers, see @ref Chrome
+            std::size_t getRingsNumber()
+            {
+                const std::lock_guard<std::mutex> lock(rings_->mutex_);
+                return (rings_->rings_.size());
+            }
+
+
+            void trace(const Event event, const std::uint32_t thread_index)
+            {
+                Ring &ring = getRing();
+                Record &record = ring.records_[ring.size_ % t_events_per_thread];
+
+                record.time_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count();
+                record.tid_ = ring.tid_;
+                record.thread_index_ = thread_index;
+                record.event_ = event;
+                ++ring.size_;
+            }
+
+
+            /**
+             * Write recorded events to a file in Chrome trace JSON format,
+             * must not be called while supervised threads are running.
+             * @return false on failure.
+             */
+            bool dump(const std::string &filename)
+            {
+                std::ofstream out(filename);
+                if (not out.is_open())
+                {
+                    return (false);
+                }
+
+                const std::int64_t pid = static_cast<std::int64_t>(getpid());
+                const std::lock_guard<std::mutex> lock(rings_->mutex_);
+
+                // microseconds with nanosecond resolution
+                out << std::fixed << std::setprecision(3);
+                out << "{\"traceEvents\": [";
+                bool first = true;
+                for (const std::unique_ptr<Ring> &ring : rings_->rings_)
+                {
+                    const std::size_t begin =
+                            (ring->size_ > t_events_per_thread) ? ring->size_ - t_events_per_thread : 0;
+                    for (std::size_t i = begin; i < ring->size_; ++i)
+                    {
+                        const Record &record = ring->records_[i % t_events_per_thread];
+
+                        out << (first ? "\n" : ",\n") << "{\"name\": \"" << getName(record.event_)
+                            << "\", \"ph\": \"" << getPhase(record.event_) << "\", \"ts\": "
+                            << static_cast<double>(record.time_ns_) / 1000.0 << ", \"pid\": " << pid
+                            << ", \"tid\": " << record.tid_ << ", \"args\": {\"thread\": " << record.thread_index_
+                            << "}";
+                        if ('i' == getPhase(record.event_))
+                        {
+                            out << ", \"s\": \"t\"";
+                        }
+                        out << "}";
+                        first = false;
+                    }
+                }
+                out << "\n]}\n";
+
+                return (out.good());
+            }
+        };
+    }  // namespace trace
+}  // namespace tut
@@ -15,3 +15,9 @@ public:
     Class &operator=(const Class &) = delete; /* NOLINT */                                                             \
     Class(Class &&) = delete;                 /* NOLINT */                                                             \
     Class &operator=(Class &&) = delete;      /* NOLINT */
+
+
+#ifndef THREAD_SUPERVISOR_CACHE_LINE_SIZE
+/// Alignment used to avoid false sharing
+#    define THREAD_SUPERVISOR_CACHE_LINE_SIZE 64
+#endif
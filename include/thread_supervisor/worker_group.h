@@ -0,0 +1,230 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Elastic group of replicated worker threads.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "supervisor.h"
+
+
+namespace tut
+{
+    namespace thread
+    {
+        /**
+         * Group of threads executing the same function, the number of
+         * replicas is kept within [min, max] bounds and can be changed at
+         * runtime either explicitly with @ref resize or automatically
+         * according to a load signal, see @ref autoscale.
+         *
+         * Replicas are retired cooperatively in LIFO order: a retired replica
+         * observes Supervisor::isInterrupted() and is not restarted, other
+         * replicas are not affected. Replicas that terminate on their own
+         * are replaced on the next resize, a new replica takes the lowest
+         * index that is not used by running replicas.
+         */
+        template <class t_Logger = log::StdErr>
+        class WorkerGroup
+        {
+            THREAD_SUPERVISOR_DISABLE_CLASS_COPY(WorkerGroup)
+
+        protected:
+            class Replica
+            {
+            public:
+                Thread::Reference reference_;
+                std::size_t index_;
+            };
+
+
+        protected:
+            const std::size_t min_size_;
+            const std::size_t max_size_;
+
+            std::mutex mutex_;
+            std::vector<Replica> replicas_;
+            std::function<Thread::Reference(std::size_t)> spawn_;
+
+            std::function<std::size_t()> load_;
+            std::size_t load_per_replica_;
+
+            Supervisor<t_Logger> supervisor_;
+
+
+        protected:
+            /// Autoscaling iteration, see @ref autoscale
+            void adjust()
+            {
+                const std::size_t load = load_();
+                resize(load / load_per_replica_ + (0 == load % load_per_replica_ ? 0 : 1));
+            }
+
+
+            /// Lowest index that is not used by replicas, indices of terminated replicas are reused
+            std::size_t getFreeIndex() const
+            {
+                std::size_t index = 0;
+                while (replicas_.end()
+                       != std::find_if(
+                               replicas_.begin(),
+                               replicas_.end(),
+                               [index](const Replica &replica) { return (replica.index_ == index); }))
+                {
+                    ++index;
+                }
+                return (index);
+            }
+
+
+        public:
+            /**
+             * @param[in] min_size minimal number of replicas
+             * @param[in] max_size maximal number of replicas
+             * @param[in] parent parent supervisor, see Supervisor
+             */
+            WorkerGroup(const std::size_t min_size, const std::size_t max_size, Supervisor<t_Logger> *parent = nullptr)
+              : min_size_(min_size)
+              , max_size_(std::max(min_size, max_size))
+              , supervisor_(Supervisor<t_Logger>::Strategy::ONE_FOR_ONE, parent)
+            {
+                load_per_replica_ = 1;
+            }
+
+
+            ~WorkerGroup()
+            {
+                stop();
+            }
+
+
+            bool stop(const std::size_t wait_ms = 10000)
+            {
+                return (supervisor_.stop(wait_ms));
+            }
+
+
+            /// Replicas should check interrupts of this supervisor
+            [[nodiscard]] Supervisor<t_Logger> &getSupervisor()
+            {
+                return (supervisor_);
+            }
+
+
+            /// Number of replicas, including the ones that have terminated since the last resize
+            [[nodiscard]] std::size_t size()
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                return (replicas_.size());
+            }
+
+
+            /**
+             * Start the minimal number of replicas: (<thread parameters>, <function pointer>, <function
+             * parameters>), must be called once. Thread names are suffixed with
+             * replica indices, see Parameters::Name. Shutdown phase of the
+             * parameters is ignored: replicas are stopped after autoscaling.
+             */
+            template <class t_Function, class... t_Args>
+            bool start(const Parameters &parameters, t_Function &&function, t_Args &&...args)
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(mutex_);
+                    spawn_ = [this,
+                              parameters,
+                              arguments = std::make_tuple(
+                                      std::forward<t_Function>(function), std::forward<t_Args>(args)...)](
+                                     const std::size_t replica)
+                    {
+                        Parameters replica_parameters(parameters);
+                        replica_parameters.name_.replica_ = replica;
+                        // replicas are stopped after the autoscaler, see @ref autoscale
+                        replica_parameters.shutdown_.phase_ = 1;
+
+                        return (std::apply(
+                                [this, &replica_parameters](const auto &...items)
+                                { return (supervisor_.spawn(Parameters(replica_parameters), items...)); },
+                                arguments));
+                    };
+                }
+                return (resize(min_size_));
+            }
+
+
+            /**
+             * Start or retire replicas, the size is clamped to [min, max], returns false if a replica was not started
+             * or if @ref start has not been called.
+             */
+            bool resize(const std::size_t size)
+            {
+                const std::size_t target_size = std::min(std::max(size, min_size_), max_size_);
+
+                const std::lock_guard<std::mutex> lock(mutex_);
+
+                if (not spawn_ or supervisor_.isInterrupted())
+                {
+                    return (false);
+                }
+
+                replicas_.erase(
+                        std::remove_if(
+                                replicas_.begin(),
+                                replicas_.end(),
+                                [this](const Replica &replica)
+                                { return (not supervisor_.isRunning(replica.reference_)); }),
+                        replicas_.end());
+
+                while (replicas_.size() > target_size)
+                {
+                    supervisor_.retire(replicas_.back().reference_);
+                    replicas_.pop_back();
+                }
+
+                while (replicas_.size() < target_size)
+                {
+                    const std::size_t index = getFreeIndex();
+                    const Thread::Reference reference = spawn_(index);
+                    if (not reference.isValid())
+                    {
+                        return (false);
+                    }
+                    replicas_.push_back(Replica{ reference, index });
+                }
+
+                return (true);
+            }
+
+
+            /**
+             * Resize periodically according to the given load signal, e.g.,
+             * queue depth: the number of replicas is ceil(load /
+             * load_per_replica), see @ref resize. Load function is called by a
+             * separate supervised thread, must be called once after @ref start.
+             */
+            template <class t_Load>
+            bool autoscale(t_Load &&load, const std::size_t load_per_replica, const std::size_t period_ms)
+            {
+                load_ = std::forward<t_Load>(load);
+                load_per_replica_ = std::max<std::size_t>(1, load_per_replica);
+
+                // autoscaling is stopped before replicas, so that it does not replace them during shutdown
+                return (supervisor_.add(
+                        Parameters(
+                                Parameters::Period(/*period_us=*/period_ms * 1000),
+                                Parameters::Shutdown(/*phase=*/0),
+                                Parameters::TerminationPolicy::IGNORE),
+                        &WorkerGroup::adjust,
+                        this));
+            }
+        };
+    }  // namespace thread
+}  // namespace tut
@@ -0,0 +1,404 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief Supervisor benchmarks, results are printed to stdout as JSON lines:
+    {"benchmark": <name>, <parameter>: <value>, "samples": <number>, "unit":
+    <unit>, "min": .., "median": .., "p90": .., "max": ..}. Logging
+    benchmarks write to stderr, which should be redirected to /dev/null.
+
+    Usage: benchmark_supervisor [<substring of benchmark names to run>]
+*/
+
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include "thread_supervisor/supervisor.h"
+#include "thread_supervisor/executor.h"
+
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+
+    /// Restart messages are not printed to avoid measuring console output
+    class SilentLogger
+    {
+    public:
+        template <class... t_Args>
+        void log(t_Args &&...) const
+        {
+        }
+    };
+
+
+    const char *filter = "";
+
+
+    bool isEnabled(const char *benchmark)
+    {
+        return (nullptr != std::strstr(benchmark, filter));
+    }
+
+
+    void report(
+            const std::string &benchmark,
+            const std::string &parameter,
+            const std::size_t parameter_value,
+            const std::string &unit,
+            std::vector<double> samples)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        std::cout << "{\"benchmark\": \"" << benchmark << "\", \"" << parameter << "\": " << parameter_value
+                  << ", \"samples\": " << samples.size() << ", \"unit\": \"" << unit
+                  << "\", \"min\": " << samples.front() << ", \"median\": " << samples[samples.size() / 2]
+                  << ", \"p90\": " << samples[samples.size() * 9 / 10] << ", \"max\": " << samples.back() << "}"
+                  << std::endl;
+    }
+
+
+    double getElapsedUs(const Clock::time_point &start)
+    {
+        return (std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+
+
+    /// CPU time of the calling thread, excludes time when the thread is preempted
+    double getThreadTimeNs()
+    {
+        timespec time;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+        return (static_cast<double>(time.tv_sec) * 1e9 + static_cast<double>(time.tv_nsec));
+    }
+
+
+    template <class t_Logger>
+    void idleWorker(const tut::thread::Supervisor<t_Logger> *supervisor)
+    {
+        while (supervisor->sleepFor(std::chrono::seconds(1)))
+        {
+            // idle
+        }
+    }
+
+
+    void emptyTask()
+    {
+    }
+
+
+    void countingTask(std::atomic<std::size_t> *counter)
+    {
+        ++(*counter);
+    }
+
+
+    /// Latency of individual add() calls
+    void benchmarkAddLatency(const std::size_t threads_number)
+    {
+        std::vector<double> samples_us;
+        samples_us.reserve(threads_number);
+
+        tut::thread::Supervisor<SilentLogger> supervisor;
+        for (std::size_t i = 0; i < threads_number; ++i)
+        {
+            const Clock::time_point start = Clock::now();
+            supervisor.add(tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)), &emptyTask);
+            samples_us.push_back(getElapsedUs(start));
+        }
+        supervisor.stop();
+
+        report("add_latency", "threads", threads_number, "us", samples_us);
+    }
+
+
+    /// Average time per add() in a batch, including termination of threads
+    void benchmarkAddThroughput(const std::size_t threads_number, const std::size_t repetitions)
+    {
+        std::vector<double> samples_us;
+        samples_us.reserve(repetitions);
+
+        for (std::size_t i = 0; i < repetitions; ++i)
+        {
+            tut::thread::Supervisor<SilentLogger> supervisor;
+
+            const Clock::time_point start = Clock::now();
+            for (std::size_t j = 0; j < threads_number; ++j)
+            {
+                supervisor.add(tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)), &emptyTask);
+            }
+            supervisor.stop();
+            samples_us.push_back(getElapsedUs(start) / static_cast<double>(threads_number));
+        }
+
+        report("add_throughput", "threads", threads_number, "us", samples_us);
+    }
+
+
+    /// Average time per restart of a trivially returning function
+    template <class t_Logger>
+    void benchmarkRestartThroughput(
+            const std::string &benchmark,
+            const std::size_t restarts_number,
+            const std::size_t repetitions)
+    {
+        std::vector<double> samples_us;
+        samples_us.reserve(repetitions);
+
+        for (std::size_t i = 0; i < repetitions; ++i)
+        {
+            std::atomic<std::size_t> counter(0);
+            tut::thread::Supervisor<t_Logger> supervisor;
+
+            const Clock::time_point start = Clock::now();
+            supervisor.add(
+                    tut::thread::Parameters(
+                            tut::thread::Parameters::Restart(/*attempts=*/restarts_number, /*sleep_ms=*/0)),
+                    &countingTask,
+                    &counter);
+            while (counter < restarts_number)
+            {
+                std::this_thread::yield();
+            }
+            samples_us.push_back(getElapsedUs(start) / static_cast<double>(restarts_number));
+            supervisor.stop();
+        }
+
+        report(benchmark, "restarts", restarts_number, "us", samples_us);
+    }
+
+
+    /// Average cost of isInterrupted() or stop token check called by supervised threads concurrently
+    template <class t_Supervisor>
+    void pollInterrupt(
+            const t_Supervisor *supervisor,
+            const bool use_token,
+            const std::atomic<bool> *go,
+            const std::size_t iterations,
+            std::atomic<std::size_t> *finished,
+            double *result_ns)
+    {
+        const tut::thread::StopToken token = supervisor->getStopToken();
+        while (not go->load())
+        {
+            std::this_thread::yield();
+        }
+
+        const double start_ns = getThreadTimeNs();
+        if (use_token)
+        {
+            for (std::size_t i = 0; i < iterations and not token.isStopRequested(); ++i)
+            {
+                // poll
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < iterations and not supervisor->isInterrupted(); ++i)
+            {
+                // poll
+            }
+        }
+        *result_ns = (getThreadTimeNs() - start_ns) / static_cast<double>(iterations);
+        ++(*finished);
+    }
+
+
+    /**
+     * Polling threads run concurrently with addition and termination of short
+     * lived threads, which modify supervisor state.
+     */
+    void benchmarkIsInterrupted(
+            const std::string &benchmark,
+            const bool use_token,
+            const std::size_t threads_number,
+            const std::size_t iterations)
+    {
+        using Supervisor = tut::thread::Supervisor<SilentLogger>;
+
+        std::vector<double> samples_ns(threads_number, 0.0);
+        std::atomic<bool> go(false);
+        std::atomic<std::size_t> finished(0);
+
+        Supervisor supervisor;
+        for (std::size_t i = 0; i < threads_number; ++i)
+        {
+            supervisor.add(
+                    tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+                    &pollInterrupt<Supervisor>,
+                    &supervisor,
+                    use_token,
+                    &go,
+                    iterations,
+                    &finished,
+                    &samples_ns[i]);
+        }
+        go = true;
+        while (finished < threads_number)
+        {
+            supervisor.add(tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)), &emptyTask);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        supervisor.stop();
+
+        report(benchmark, "threads", threads_number, "ns", samples_ns);
+    }
+
+
+    void benchmarkStopLatency(const std::size_t threads_number, const std::size_t repetitions)
+    {
+        std::vector<double> samples_us;
+        samples_us.reserve(repetitions);
+
+        for (std::size_t i = 0; i < repetitions; ++i)
+        {
+            tut::thread::Supervisor<SilentLogger> supervisor;
+            for (std::size_t j = 0; j < threads_number; ++j)
+            {
+                supervisor.add(tut::thread::Parameters(), &idleWorker<SilentLogger>, &supervisor);
+            }
+
+            const Clock::time_point start = Clock::now();
+            supervisor.stop();
+            samples_us.push_back(getElapsedUs(start));
+        }
+
+        report("stop_latency", "threads", threads_number, "us", samples_us);
+    }
+
+
+    /// Average time per task executed by a separate thread, baseline for @ref benchmarkExecutor
+    void benchmarkAddPerTask(const std::size_t tasks_number, const std::size_t repetitions)
+    {
+        std::vector<double> samples_us;
+        samples_us.reserve(repetitions);
+
+        for (std::size_t i = 0; i < repetitions; ++i)
+        {
+            std::atomic<std::size_t> counter(0);
+            tut::thread::Supervisor<SilentLogger> supervisor;
+
+            const Clock::time_point start = Clock::now();
+            for (std::size_t j = 0; j < tasks_number; ++j)
+            {
+                supervisor.add(
+                        tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+                        &countingTask,
+                        &counter);
+            }
+            while (counter < tasks_number)
+            {
+                std::this_thread::yield();
+            }
+            samples_us.push_back(getElapsedUs(start) / static_cast<double>(tasks_number));
+            supervisor.stop();
+        }
+
+        report("add_per_task", "tasks", tasks_number, "us", samples_us);
+    }
+
+
+    /// Average time per task executed by the executor, see @ref benchmarkAddPerTask
+    void benchmarkExecutor(const std::size_t tasks_number, const std::size_t repetitions)
+    {
+        std::vector<double> samples_us;
+        samples_us.reserve(repetitions);
+
+        for (std::size_t i = 0; i < repetitions; ++i)
+        {
+            std::atomic<std::size_t> counter(0);
+            tut::thread::Executor<> executor(std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+
+            const Clock::time_point start = Clock::now();
+            for (std::size_t j = 0; j < tasks_number; ++j)
+            {
+                while (not executor.submit([&counter]() { ++counter; }))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            while (counter < tasks_number)
+            {
+                std::this_thread::yield();
+            }
+            samples_us.push_back(getElapsedUs(start) / static_cast<double>(tasks_number));
+        }
+
+        report("executor", "tasks", tasks_number, "us", samples_us);
+    }
+}  // namespace
+
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        filter = argv[1];
+    }
+
+    if (isEnabled("add_latency"))
+    {
+        benchmarkAddLatency(1000);
+    }
+
+    if (isEnabled("add_throughput"))
+    {
+        for (const std::size_t threads_number : { 100, 1000 })
+        {
+            benchmarkAddThroughput(threads_number, 10);
+        }
+    }
+
+    for (const std::size_t restarts_number : { 1000, 100000 })
+    {
+        if (isEnabled("restart_per_attempt"))
+        {
+            benchmarkRestartThroughput<SilentLogger>("restart_per_attempt", restarts_number, 10);
+        }
+        // restart messages are written to stderr
+        if (isEnabled("restart_per_attempt_logging"))
+        {
+            benchmarkRestartThroughput<tut::log::StdErr>("restart_per_attempt_logging", restarts_number, 10);
+        }
+    }
+
+    for (const std::size_t threads_number : { 1, 4, 16, 64, 128 })
+    {
+        if (isEnabled("is_interrupted"))
+        {
+            benchmarkIsInterrupted("is_interrupted", false, threads_number, 1000000);
+        }
+        if (isEnabled("stop_token"))
+        {
+            benchmarkIsInterrupted("stop_token", true, threads_number, 1000000);
+        }
+    }
+
+    if (isEnabled("stop_latency"))
+    {
+        for (const std::size_t threads_number : { 1, 16, 64, 256 })
+        {
+            benchmarkStopLatency(threads_number, 10);
+        }
+    }
+
+    for (const std::size_t tasks_number : { 100, 1000 })
+    {
+        if (isEnabled("add_per_task"))
+        {
+            benchmarkAddPerTask(tasks_number, 10);
+        }
+        if (isEnabled("executor"))
+        {
+            benchmarkExecutor(tasks_number, 10);
+        }
+    }
+
+    return (EXIT_SUCCESS);
+}
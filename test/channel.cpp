@@ -0,0 +1,210 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief
+*/
+
+
+#define BOOST_TEST_MODULE channel
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/results_reporter.hpp>
+
+
+struct GlobalFixtureConfig
+{
+    GlobalFixtureConfig()
+    {
+        boost::unit_test::results_reporter::set_level(boost::unit_test::DETAILED_REPORT);
+    }
+    ~GlobalFixtureConfig() = default;
+};
+
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+// Depending on Boost version a compiler may issue a warning about extra ';',
+// at the same time, compilation may fail on some systems if ';' is omitted.
+BOOST_GLOBAL_FIXTURE(GlobalFixtureConfig);
+#pragma GCC diagnostic pop
+
+
+
+#include "thread_supervisor/channel.h"
+
+
+namespace
+{
+    const std::size_t items_number = 10000;
+
+
+    template <class t_Channel>
+    void produce(t_Channel *channel)
+    {
+        for (std::size_t i = 1; i <= items_number; ++i)
+        {
+            if (not channel->push(i))
+            {
+                return;
+            }
+        }
+    }
+
+
+    template <class t_Channel>
+    void consume(t_Channel *channel, std::atomic<std::size_t> *sum, std::atomic<std::size_t> *counter)
+    {
+        std::size_t item = 0;
+        while (channel->pop(item))
+        {
+            *sum += item;
+            ++(*counter);
+        }
+    }
+
+
+    /// Restarted after each item, the channel is preserved
+    template <class t_Channel>
+    void consumeAndThrow(t_Channel *channel, std::atomic<std::size_t> *sum, std::atomic<std::size_t> *counter)
+    {
+        std::size_t item = 0;
+        if (channel->pop(item))
+        {
+            *sum += item;
+            ++(*counter);
+            throw std::runtime_error("consumer failure");
+        }
+    }
+
+
+    class SilentLogger
+    {
+    public:
+        template <class... t_Args>
+        void log(t_Args &&...) const
+        {
+        }
+    };
+
+
+    template <class t_Channel>
+    void checkTransfer(const std::size_t producers_number)
+    {
+        std::atomic<std::size_t> sum(0);
+        std::atomic<std::size_t> counter(0);
+
+        tut::thread::Supervisor<> supervisor;
+        t_Channel channel(supervisor, /*capacity=*/16);
+
+        supervisor.add(
+                tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+                &consume<t_Channel>,
+                &channel,
+                &sum,
+                &counter);
+        for (std::size_t i = 0; i < producers_number; ++i)
+        {
+            supervisor.add(
+                    tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+                    &produce<t_Channel>,
+                    &channel);
+        }
+
+        for (std::size_t i = 0; i < 1000 and counter < producers_number * items_number; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        BOOST_CHECK(supervisor.stop());
+
+        BOOST_CHECK_EQUAL(counter, producers_number * items_number);
+        BOOST_CHECK_EQUAL(sum, producers_number * items_number * (items_number + 1) / 2);
+        BOOST_CHECK_GT(channel.getHighWaterMark(), static_cast<std::size_t>(0));
+        BOOST_CHECK_LE(channel.getHighWaterMark(), channel.capacity());
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(ChannelTransfer)
+{
+    checkTransfer<tut::thread::SPSCChannel<std::size_t>>(1);
+    checkTransfer<tut::thread::Channel<std::size_t>>(1);
+    checkTransfer<tut::thread::Channel<std::size_t>>(4);
+}
+
+
+BOOST_AUTO_TEST_CASE(ChannelInterrupt)
+{
+    tut::thread::Supervisor<> supervisor;
+    tut::thread::Channel<std::size_t> empty_channel(supervisor, /*capacity=*/4);
+    tut::thread::Channel<std::size_t> full_channel(supervisor, /*capacity=*/4);
+
+    for (std::size_t i = 0; i < full_channel.capacity(); ++i)
+    {
+        BOOST_CHECK(full_channel.tryPush(i));
+    }
+    BOOST_CHECK(not full_channel.tryPush(0));
+    BOOST_CHECK_EQUAL(full_channel.size(), static_cast<std::size_t>(4));
+    BOOST_CHECK_EQUAL(full_channel.getHighWaterMark(), static_cast<std::size_t>(4));
+
+    std::atomic<std::size_t> sum(0);
+    std::atomic<std::size_t> counter(0);
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+            &consume<tut::thread::Channel<std::size_t>>,
+            &empty_channel,
+            &sum,
+            &counter);
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+            &produce<tut::thread::Channel<std::size_t>>,
+            &full_channel);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // both threads are blocked
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    BOOST_CHECK(supervisor.stop());
+    BOOST_CHECK_LT(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+            100);
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(0));
+
+    // items can be drained after interrupt
+    std::size_t item = 0;
+    BOOST_CHECK(full_channel.pop(item));
+    BOOST_CHECK_EQUAL(item, static_cast<std::size_t>(0));
+    BOOST_CHECK(not full_channel.push(item));
+}
+
+
+BOOST_AUTO_TEST_CASE(ChannelRestart)
+{
+    using Channel = tut::thread::SPSCChannel<std::size_t, SilentLogger>;
+
+    std::atomic<std::size_t> sum(0);
+    std::atomic<std::size_t> counter(0);
+
+    tut::thread::Supervisor<SilentLogger> supervisor;
+    Channel channel(supervisor, /*capacity=*/16);
+
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/0)),
+            &consumeAndThrow<Channel>,
+            &channel,
+            &sum,
+            &counter);
+    for (std::size_t i = 1; i <= 100; ++i)
+    {
+        BOOST_CHECK(channel.push(i));
+    }
+
+    for (std::size_t i = 0; i < 1000 and counter < 100; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    BOOST_CHECK(supervisor.stop());
+
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(100));
+    BOOST_CHECK_EQUAL(sum, static_cast<std::size_t>(5050));
+}
@@ -0,0 +1,8 @@
+function(tut_add_benchmark     BENCHMARK_NAME   BENCHMARK_SOURCES)
+    set(TGT_NAME   "TGT_${BENCHMARK_NAME}")
+    add_executable(${TGT_NAME} "${BENCHMARK_SOURCES}")
+    set_target_properties(${TGT_NAME} PROPERTIES OUTPUT_NAME "${BENCHMARK_NAME}")
+    target_link_libraries(${TGT_NAME}
+        thread_supervisor
+    )
+endfunction()
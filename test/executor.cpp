@@ -0,0 +1,114 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief
+*/
+
+
+#define BOOST_TEST_MODULE executor
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/results_reporter.hpp>
+
+
+struct GlobalFixtureConfig
+{
+    GlobalFixtureConfig()
+    {
+        boost::unit_test::results_reporter::set_level(boost::unit_test::DETAILED_REPORT);
+    }
+    ~GlobalFixtureConfig() = default;
+};
+
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+// Depending on Boost version a compiler may issue a warning about extra ';',
+// at the same time, compilation may fail on some systems if ';' is omitted.
+BOOST_GLOBAL_FIXTURE(GlobalFixtureConfig);
+#pragma GCC diagnostic pop
+
+
+#include "thread_supervisor/executor.h"
+
+
+BOOST_AUTO_TEST_CASE(WorkStealingDeque)
+{
+    tut::thread::WorkStealingDeque<std::size_t> deque(4);
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        BOOST_CHECK(deque.push(i));
+    }
+    BOOST_CHECK(not deque.push(4));
+    BOOST_CHECK_EQUAL(deque.size(), static_cast<std::size_t>(4));
+
+    std::size_t item = 0;
+    BOOST_CHECK(deque.steal(item));
+    BOOST_CHECK_EQUAL(item, static_cast<std::size_t>(0));
+
+    BOOST_CHECK(deque.pop(item));
+    BOOST_CHECK_EQUAL(item, static_cast<std::size_t>(3));
+    BOOST_CHECK(deque.pop(item));
+    BOOST_CHECK_EQUAL(item, static_cast<std::size_t>(2));
+    BOOST_CHECK(deque.steal(item));
+    BOOST_CHECK_EQUAL(item, static_cast<std::size_t>(1));
+
+    BOOST_CHECK(not deque.pop(item));
+    BOOST_CHECK(not deque.steal(item));
+}
+
+
+BOOST_AUTO_TEST_CASE(ExecutorTasks)
+{
+    std::atomic<std::size_t> counter(0);
+    const std::size_t tasks_number = 10000;
+
+    tut::thread::Executor<> executor(/*workers_number=*/4);
+
+    for (std::size_t i = 0; i < tasks_number; ++i)
+    {
+        while (not executor.submit([&counter]() { ++counter; }))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::size_t i = 0; i < 1000 and counter < tasks_number; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(counter, tasks_number);
+    BOOST_CHECK(executor.stop());
+}
+
+
+BOOST_AUTO_TEST_CASE(ExecutorRestart)
+{
+    std::atomic<std::size_t> counter(0);
+    const std::size_t tasks_number = 100;
+
+    tut::thread::Executor<> executor(
+            /*workers_number=*/1, tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/0)));
+
+    // tasks are queued in the deque of the worker, which is restarted after
+    // the first task throws
+    executor.submit(
+            [&executor, &counter, tasks_number]()
+            {
+                for (std::size_t i = 0; i < tasks_number; ++i)
+                {
+                    executor.submit([&counter]() { ++counter; });
+                }
+                throw std::runtime_error("test exception");
+            });
+
+    for (std::size_t i = 0; i < 1000 and counter < tasks_number; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(counter, tasks_number);
+    BOOST_CHECK(executor.stop());
+}
@@ -33,6 +33,8 @@ BOOST_GLOBAL_FIXTURE(GlobalFixtureConfig);
 
 
 #include "thread_supervisor/supervisor.h"
+#include "thread_supervisor/async_logger.h"
+#include "thread_supervisor/trace.h"
 
 
 namespace
@@ -62,11 +64,59 @@ namespace
             }
         }
 
+        void threadSleepFor()
+        {
+            while (getThreadSupervisor().sleepFor(std::chrono::seconds(1)))
+            {
+                // work
+            }
+        }
+
         void threadCounter()
         {
             ++counter_;
         }
 
+        void threadArguments(const std::string &text, std::size_t number)
+        {
+            if (std::string(64, 'x') == text and 42 == number)
+            {
+                ++counter_;
+            }
+        }
+
+        void threadSleep()
+        {
+            ++counter_;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        void threadOverrunOnce()
+        {
+            if (0 == counter_++)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(350));
+            }
+        }
+
+        void threadHeartbeat()
+        {
+            while (getThreadSupervisor().sleepFor(std::chrono::milliseconds(10)))
+            {
+                getThreadSupervisor().heartbeat();
+            }
+        }
+
+        void threadAffinityCounter()
+        {
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            if (0 == pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) and 1 == CPU_COUNT(&cpu_set))
+            {
+                ++counter_;
+            }
+        }
+
         TestThreadSupervisor()
         {
             counter_ = 0;
@@ -77,6 +127,23 @@ namespace
             stopSupervisedThreads();
         }
     };
+
+
+    /// Polls the predicate until it holds or the timeout expires, timing-sensitive checks should use it
+    template <class t_Predicate>
+    bool waitFor(t_Predicate &&predicate, const std::chrono::milliseconds timeout = std::chrono::seconds(10))
+    {
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+        while (not predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return (false);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return (true);
+    }
 }  // namespace
 
 
@@ -107,3 +174,1151 @@ BOOST_AUTO_TEST_CASE(ThreadSupervisorCount)
     BOOST_CHECK_EQUAL(pool.counter_, static_cast<std::size_t>(10));
     BOOST_CHECK(not pool.isThreadSupervisorInterrupted());
 }
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorInterruptSleep)
+{
+    const boost::timer::cpu_timer timer;
+    {
+        TestThreadSupervisor pool;
+        pool.addSupervisedThread(
+                tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/0, /*sleep_ms=*/100000)),
+                &TestThreadSupervisor::threadCounter,
+                &pool);
+        pool.addSupervisedThread(tut::thread::Parameters(), &TestThreadSupervisor::threadSleepFor, &pool);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    // neither the restart delay nor the sleep in threadSleepFor() delay stop()
+    BOOST_CHECK_LT(timer.elapsed().wall, boost::timer::nanosecond_type(1000000000));
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorBackoff)
+{
+    std::minstd_rand generator;
+
+    const tut::thread::Parameters::Restart restart(
+            /*attempts=*/0,
+            /*sleep_ms=*/10,
+            tut::thread::Parameters::Restart::Backoff(/*factor=*/2.0, /*max_sleep_ms=*/100));
+    BOOST_CHECK_EQUAL(restart.getDelay(1, generator).count(), 10);
+    BOOST_CHECK_EQUAL(restart.getDelay(2, generator).count(), 20);
+    BOOST_CHECK_EQUAL(restart.getDelay(4, generator).count(), 80);
+    BOOST_CHECK_EQUAL(restart.getDelay(5, generator).count(), 100);
+    BOOST_CHECK_EQUAL(restart.getDelay(1000, generator).count(), 100);
+
+    // the delay is computed in constant time for any attempt number
+    const tut::thread::Parameters::Restart constant_restart(/*attempts=*/0, /*sleep_ms=*/10);
+    BOOST_CHECK_EQUAL(constant_restart.getDelay(std::numeric_limits<std::size_t>::max(), generator).count(), 10);
+    const tut::thread::Parameters::Restart unlimited_restart(
+            /*attempts=*/0, /*sleep_ms=*/10, tut::thread::Parameters::Restart::Backoff(/*factor=*/2.0));
+    BOOST_CHECK_EQUAL(
+            unlimited_restart.getDelay(std::numeric_limits<std::size_t>::max(), generator).count(),
+            static_cast<std::chrono::milliseconds::rep>(std::numeric_limits<std::uint32_t>::max()));
+
+    const tut::thread::Parameters::Restart jittered_restart(
+            /*attempts=*/0,
+            /*sleep_ms=*/100,
+            tut::thread::Parameters::Restart::Backoff(/*factor=*/1.0, /*max_sleep_ms=*/0, /*jitter=*/0.5));
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        const std::chrono::milliseconds::rep delay = jittered_restart.getDelay(1, generator).count();
+        BOOST_CHECK_GE(delay, 50);
+        BOOST_CHECK_LE(delay, 100);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorCircuitBreaker)
+{
+    TestThreadSupervisor pool;
+
+    pool.addSupervisedThread(
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Restart(
+                            /*attempts=*/0,
+                            /*sleep_ms=*/0,
+                            tut::thread::Parameters::Restart::Backoff(),
+                            tut::thread::Parameters::Restart::CircuitBreaker(/*max_restarts=*/5, /*window_ms=*/10000)),
+                    tut::thread::Parameters::TerminationPolicy::KILLALL),
+            &TestThreadSupervisor::threadCounter,
+            &pool);
+
+    BOOST_CHECK(waitFor([&pool]() { return (pool.isThreadSupervisorInterrupted()); }));
+    BOOST_CHECK(pool.getThreadSupervisor().stop());
+    BOOST_CHECK_EQUAL(pool.counter_, static_cast<std::size_t>(6));
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorCPUList)
+{
+    BOOST_CHECK(tut::thread::cpu::parseList("0-3,8,10-11\n") == tut::thread::cpu::Set({ 0, 1, 2, 3, 8, 10, 11 }));
+    BOOST_CHECK(tut::thread::cpu::parseList("5,1-2") == tut::thread::cpu::Set({ 1, 2, 5 }));
+    BOOST_CHECK(tut::thread::cpu::parseList("").empty());
+    BOOST_CHECK(tut::thread::cpu::parseList("x-1").empty());
+    BOOST_CHECK(not tut::thread::cpu::getAllowed().empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorAffinity)
+{
+    TestThreadSupervisor pool;
+
+    const tut::thread::Parameters::Scheduling scheduling(
+            /*priority=*/0,
+            /*policy=*/SCHED_FIFO,
+            /*ignore_failures=*/false,
+            tut::thread::Parameters::Scheduling::Affinity(
+                    tut::thread::cpu::Set(),
+                    /*numa_node=*/-1,
+                    tut::thread::Parameters::Scheduling::Affinity::Placement::ROUND_ROBIN));
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        pool.addSupervisedThread(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Restart(/*attempts=*/1),
+                        tut::thread::Parameters::Scheduling(scheduling)),
+                &TestThreadSupervisor::threadAffinityCounter,
+                &pool);
+    }
+
+    BOOST_CHECK(waitFor([&pool]() { return (pool.counter_ >= 4); }));
+    BOOST_CHECK(pool.getThreadSupervisor().stop());
+    BOOST_CHECK_EQUAL(pool.counter_, static_cast<std::size_t>(4));
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorSchedulingFailure)
+{
+    TestThreadSupervisor pool;
+
+    const tut::thread::Parameters::Scheduling::Affinity invalid_affinity(tut::thread::cpu::Set({ CPU_SETSIZE }));
+
+    BOOST_CHECK(not pool.addSupervisedThread(
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Restart(/*attempts=*/1),
+                    tut::thread::Parameters::Scheduling(
+                            /*priority=*/0, /*policy=*/SCHED_FIFO, /*ignore_failures=*/false, invalid_affinity)),
+            &TestThreadSupervisor::threadCounter,
+            &pool));
+
+    BOOST_CHECK(pool.addSupervisedThread(
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Restart(/*attempts=*/1),
+                    tut::thread::Parameters::Scheduling(
+                            /*priority=*/0, /*policy=*/SCHED_FIFO, /*ignore_failures=*/true, invalid_affinity)),
+            &TestThreadSupervisor::threadCounter,
+            &pool));
+
+    BOOST_CHECK(waitFor([&pool]() { return (pool.counter_ >= 1); }));
+    BOOST_CHECK(pool.getThreadSupervisor().stop());
+    BOOST_CHECK_EQUAL(pool.counter_, static_cast<std::size_t>(1));
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorQueue)
+{
+    tut::thread::MPMCQueue<std::size_t> queue(3);
+    BOOST_CHECK_EQUAL(queue.capacity(), static_cast<std::size_t>(4));
+
+    for (std::size_t i = 0; i < queue.capacity(); ++i)
+    {
+        BOOST_CHECK(queue.push(i));
+    }
+    BOOST_CHECK(not queue.push(0));
+    BOOST_CHECK_EQUAL(queue.size(), static_cast<std::size_t>(4));
+
+    std::size_t item = 0;
+    for (std::size_t i = 0; i < queue.capacity(); ++i)
+    {
+        BOOST_CHECK(queue.pop(item));
+        BOOST_CHECK_EQUAL(item, i);
+    }
+    BOOST_CHECK(not queue.pop(item));
+}
+
+
+namespace
+{
+    void throwException()
+    {
+        throw std::runtime_error("test exception");
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorAsyncLogger)
+{
+    tut::thread::Supervisor<tut::log::Async<>> supervisor;
+
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/10, /*sleep_ms=*/0)),
+            &throwException);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    BOOST_CHECK(supervisor.stop());
+    BOOST_CHECK_EQUAL(supervisor.getDroppedMessages(), static_cast<std::size_t>(0));
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorRegistry)
+{
+    tut::thread::Registry<std::size_t, /*chunk_size=*/2, /*max_chunks=*/2> registry;
+
+    std::vector<tut::thread::RegistryHandle> handles;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        handles.push_back(registry.acquire());
+        BOOST_REQUIRE(handles.back().isValid());
+        registry.get(handles.back()) = i;
+        // not visible until initialized
+        BOOST_CHECK(not registry.find(handles.back()));
+        registry.publish(handles.back());
+        BOOST_CHECK(registry.find(handles.back()));
+    }
+    BOOST_CHECK(not registry.acquire().isValid());
+    BOOST_CHECK_EQUAL(registry.size(), static_cast<std::size_t>(4));
+
+    registry.terminate(handles[1]);
+    BOOST_CHECK(registry.hasTerminated());
+
+    std::size_t reaped_item = 0;
+    BOOST_CHECK_EQUAL(
+            registry.reap([&reaped_item](const std::size_t &item) { reaped_item = item; }), static_cast<std::size_t>(1));
+    BOOST_CHECK_EQUAL(reaped_item, static_cast<std::size_t>(1));
+    BOOST_CHECK_EQUAL(registry.size(), static_cast<std::size_t>(3));
+    BOOST_CHECK(not registry.find(handles[1]));
+    BOOST_CHECK(registry.find(handles[0]));
+
+    const tut::thread::RegistryHandle handle = registry.acquire();
+    BOOST_CHECK(handle.isValid());
+    BOOST_CHECK_EQUAL(handle.index_, handles[1].index_);
+    BOOST_CHECK(handle != handles[1]);
+
+    std::size_t counter = 0;
+    registry.forEach([&counter](const tut::thread::RegistryHandle &, const std::size_t &) { ++counter; });
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(3));
+
+    registry.publish(handle);
+    counter = 0;
+    registry.forEach([&counter](const tut::thread::RegistryHandle &, const std::size_t &) { ++counter; });
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(4));
+
+    // the slot is not released while it is pinned by a reader
+    auto guard = registry.find(handles[0]);
+    BOOST_REQUIRE(guard);
+    registry.terminate(handles[0]);
+    std::atomic<bool> reaped(false);
+    std::thread reaper(
+            [&registry, &reaped]()
+            {
+                registry.reap([](const std::size_t &) {});
+                reaped = true;
+            });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK(not reaped);
+    BOOST_CHECK_EQUAL(*guard, static_cast<std::size_t>(0));
+    guard.reset();
+    reaper.join();
+    BOOST_CHECK(reaped);
+    BOOST_CHECK(not registry.find(handles[0]));
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorShortLivedThreads)
+{
+    TestThreadSupervisor pool;
+
+    const std::size_t threads_number = 200;
+    for (std::size_t i = 0; i < threads_number; ++i)
+    {
+        BOOST_CHECK(pool.addSupervisedThread(
+                tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+                &TestThreadSupervisor::threadCounter,
+                &pool));
+    }
+
+    BOOST_CHECK(pool.getThreadSupervisor().stop());
+    BOOST_CHECK_EQUAL(pool.counter_, threads_number);
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorShortLivedWatchdog)
+{
+    // slots of short-lived threads are reused while the watchdog and readers use them, mainly a TSan check
+    TestThreadSupervisor pool;
+    tut::thread::Supervisor<> &supervisor = pool.getThreadSupervisor();
+
+    std::atomic<bool> done(false);
+    std::thread reader(
+            [&supervisor, &done]()
+            {
+                while (not done)
+                {
+                    supervisor.getMetrics();
+                    supervisor.getCrashReports();
+                }
+            });
+
+    const std::size_t threads_number = 200;
+    tut::thread::Thread::Reference previous;
+    for (std::size_t i = 0; i < threads_number; ++i)
+    {
+        const tut::thread::Thread::Reference reference = supervisor.spawn(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Restart(/*attempts=*/1),
+                        tut::thread::Parameters::Heartbeat(/*timeout_ms=*/10),
+                        tut::thread::Parameters::Budget(/*cpu_ms=*/1000, /*window_ms=*/10)),
+                &TestThreadSupervisor::threadCounter,
+                &pool);
+        BOOST_CHECK(reference.isValid());
+        // usually stale
+        supervisor.retire(previous);
+        previous = reference;
+    }
+
+    done = true;
+    reader.join();
+    BOOST_CHECK(supervisor.stop());
+    BOOST_CHECK_EQUAL(pool.counter_, threads_number);
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorMetrics)
+{
+    tut::thread::Supervisor<tut::log::Async<>> supervisor;
+
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/0, /*sleep_ms=*/10)),
+            &throwException);
+
+    std::vector<tut::thread::Metrics> metrics;
+    BOOST_CHECK(waitFor(
+            [&supervisor, &metrics]()
+            {
+                metrics = supervisor.getMetrics();
+                return (1 == metrics.size() and metrics[0].restarts_ > 1 and metrics[0].cpu_time_.count() > 0);
+            }));
+    BOOST_REQUIRE_EQUAL(metrics.size(), static_cast<std::size_t>(1));
+    BOOST_CHECK(metrics[0].running_);
+    BOOST_CHECK_GT(metrics[0].restarts_, static_cast<std::size_t>(1));
+    BOOST_CHECK_GE(metrics[0].exceptions_, metrics[0].restarts_);
+    BOOST_CHECK(tut::thread::Metrics::ExitReason::EXCEPTION == metrics[0].last_exit_reason_);
+    BOOST_CHECK_EQUAL(metrics[0].last_exception_type_, "std::runtime_error");
+    BOOST_CHECK_GT(metrics[0].backoff_time_.count(), 0);
+    BOOST_CHECK_GE(metrics[0].wall_time_.count(), metrics[0].backoff_time_.count());
+    BOOST_CHECK_GT(metrics[0].cpu_time_.count(), 0);
+
+    BOOST_CHECK(supervisor.stop());
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorHeartbeat)
+{
+    const tut::thread::Parameters::Heartbeat heartbeat(
+            /*timeout_ms=*/100, tut::thread::Parameters::Heartbeat::Action::TERMINATE);
+
+    {
+        TestThreadSupervisor pool;
+        pool.addSupervisedThread(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Heartbeat(heartbeat),
+                        tut::thread::Parameters::TerminationPolicy::KILLALL),
+                &TestThreadSupervisor::threadHeartbeat,
+                &pool);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        BOOST_CHECK(not pool.isThreadSupervisorInterrupted());
+        // the watchdog is not reported
+        BOOST_CHECK_EQUAL(pool.getThreadSupervisor().getMetrics().size(), static_cast<std::size_t>(1));
+    }
+
+    {
+        // stalled thread is stopped without restart, other threads are not affected
+        TestThreadSupervisor pool;
+        tut::thread::Supervisor<> &supervisor = pool.getThreadSupervisor();
+        const tut::thread::Thread::Reference stalled = supervisor.spawn(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Heartbeat(heartbeat),
+                        tut::thread::Parameters::Restart(/*attempts=*/0),
+                        tut::thread::Parameters::TerminationPolicy::IGNORE),
+                &TestThreadSupervisor::threadSleepFor,
+                &pool);
+        const tut::thread::Thread::Reference healthy =
+                supervisor.spawn(tut::thread::Parameters(), &TestThreadSupervisor::threadSleepFor, &pool);
+
+        BOOST_CHECK(waitFor([&supervisor, &stalled]() { return (not supervisor.isRunning(stalled)); }));
+        BOOST_CHECK(supervisor.isRunning(healthy));
+        BOOST_CHECK(not pool.isThreadSupervisorInterrupted());
+    }
+
+    {
+        TestThreadSupervisor pool;
+        pool.addSupervisedThread(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Heartbeat(heartbeat),
+                        tut::thread::Parameters::TerminationPolicy::KILLALL),
+                &TestThreadSupervisor::threadSleepFor,
+                &pool);
+
+        BOOST_CHECK(waitFor([&pool]() { return (pool.isThreadSupervisorInterrupted()); }));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorPeriod)
+{
+    {
+        TestThreadSupervisor pool;
+        pool.addSupervisedThread(
+                tut::thread::Parameters(tut::thread::Parameters::Period(/*period_us=*/10000)),
+                &TestThreadSupervisor::threadCounter,
+                &pool);
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        BOOST_CHECK(waitFor([&pool]() { return (pool.counter_ >= 20); }));
+
+        // the first iteration is not delayed, the rest are not early
+        BOOST_CHECK_GE(
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+                190);
+
+        const std::vector<tut::thread::Metrics> metrics = pool.getThreadSupervisor().getMetrics();
+        BOOST_REQUIRE_EQUAL(metrics.size(), static_cast<std::size_t>(1));
+        BOOST_CHECK_GT(metrics[0].periods_, static_cast<std::size_t>(0));
+        BOOST_CHECK_GE(metrics[0].max_jitter_.count(), metrics[0].mean_jitter_.count());
+    }
+
+    {
+        TestThreadSupervisor pool;
+        pool.addSupervisedThread(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Period(
+                                /*period_us=*/5000,
+                                tut::thread::Parameters::Period::Mode::FIXED_RATE,
+                                tut::thread::Parameters::Period::Overrun::ESCALATE),
+                        tut::thread::Parameters::TerminationPolicy::KILLALL),
+                &TestThreadSupervisor::threadSleep,
+                &pool);
+
+        BOOST_CHECK(waitFor([&pool]() { return (pool.isThreadSupervisorInterrupted()); }));
+        BOOST_CHECK_EQUAL(pool.counter_, static_cast<std::size_t>(1));
+    }
+
+    {
+        // the first iteration overruns three deadlines, which are counted once
+        TestThreadSupervisor pool;
+        pool.addSupervisedThread(
+                tut::thread::Parameters(tut::thread::Parameters::Period(
+                        /*period_us=*/100000,
+                        tut::thread::Parameters::Period::Mode::FIXED_RATE,
+                        tut::thread::Parameters::Period::Overrun::CATCH_UP)),
+                &TestThreadSupervisor::threadOverrunOnce,
+                &pool);
+
+        std::vector<tut::thread::Metrics> metrics;
+        BOOST_CHECK(waitFor(
+                [&pool, &metrics]()
+                {
+                    metrics = pool.getThreadSupervisor().getMetrics();
+                    return (1 == metrics.size() and metrics[0].periods_ >= 5);
+                }));
+        BOOST_REQUIRE_EQUAL(metrics.size(), static_cast<std::size_t>(1));
+        BOOST_CHECK_EQUAL(metrics[0].missed_deadlines_, static_cast<std::size_t>(3));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorArguments)
+{
+    TestThreadSupervisor pool;
+
+    // lvalue arguments are copied once and reused on restart
+    const std::string text(64, 'x');
+    const std::size_t number = 42;
+    pool.addSupervisedThread(
+            tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/5, /*sleep_ms=*/0)),
+            &TestThreadSupervisor::threadArguments,
+            &pool,
+            text,
+            number);
+
+    BOOST_CHECK(waitFor([&pool]() { return (pool.counter_ >= 5); }));
+    BOOST_CHECK(pool.getThreadSupervisor().stop());
+    BOOST_CHECK_EQUAL(pool.counter_, static_cast<std::size_t>(5));
+}
+
+
+namespace
+{
+    void countAndIdle(const tut::thread::Supervisor<> *supervisor, std::atomic<std::size_t> *counter)
+    {
+        ++(*counter);
+        while (supervisor->sleepFor(std::chrono::seconds(1)))
+        {
+            // idle
+        }
+    }
+
+
+    void countAndReturn(std::atomic<std::size_t> *counter, const std::atomic<std::size_t> *last)
+    {
+        ++(*counter);
+        // let the rest of the group start
+        waitFor([last]() { return (*last > 0); });
+    }
+
+
+    void checkStrategy(
+            const tut::thread::Supervisor<>::Strategy strategy,
+            const std::size_t expected_first,
+            const std::size_t expected_last)
+    {
+        tut::thread::Supervisor<> supervisor(strategy);
+        std::atomic<std::size_t> first(0);
+        std::atomic<std::size_t> failing(0);
+        std::atomic<std::size_t> last(0);
+
+        supervisor.add(tut::thread::Parameters(), &countAndIdle, &supervisor, &first);
+        BOOST_CHECK(waitFor([&first]() { return (first > 0); }));
+        // the first attempt ends and triggers group restart, the second does not
+        supervisor.add(
+                tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/2, /*sleep_ms=*/10)),
+                &countAndReturn,
+                &failing,
+                &last);
+        supervisor.add(tut::thread::Parameters(), &countAndIdle, &supervisor, &last);
+
+        BOOST_CHECK(waitFor([&failing, &first, &last, expected_first, expected_last]()
+                { return (2 == failing and expected_first == first and expected_last == last); }));
+
+        BOOST_CHECK(supervisor.stop());
+        BOOST_CHECK_EQUAL(failing, static_cast<std::size_t>(2));
+        BOOST_CHECK_EQUAL(first, expected_first);
+        BOOST_CHECK_EQUAL(last, expected_last);
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorStrategy)
+{
+    checkStrategy(tut::thread::Supervisor<>::Strategy::ONE_FOR_ONE, 1, 1);
+    checkStrategy(tut::thread::Supervisor<>::Strategy::ONE_FOR_ALL, 2, 2);
+    checkStrategy(tut::thread::Supervisor<>::Strategy::REST_FOR_ONE, 1, 2);
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorTree)
+{
+    std::atomic<std::size_t> root_counter(0);
+    std::atomic<std::size_t> first_counter(0);
+    std::atomic<std::size_t> second_counter(0);
+
+    tut::thread::Supervisor<> root;
+    tut::thread::Supervisor<> first(tut::thread::Supervisor<>::Strategy::ONE_FOR_ONE, &root);
+    tut::thread::Supervisor<> second(tut::thread::Supervisor<>::Strategy::ONE_FOR_ONE, &root);
+
+    root.add(tut::thread::Parameters(), &countAndIdle, &root, &root_counter);
+    first.add(tut::thread::Parameters(), &countAndIdle, &first, &first_counter);
+    second.add(tut::thread::Parameters(), &countAndIdle, &second, &second_counter);
+    BOOST_CHECK(waitFor([&root_counter, &first_counter, &second_counter]()
+                        { return (1 == root_counter and 1 == first_counter and 1 == second_counter); }));
+
+    // stopping a subtree does not affect the rest of the tree
+    BOOST_CHECK(first.stop());
+    BOOST_CHECK(first.isInterrupted());
+    BOOST_CHECK(not root.isInterrupted());
+    BOOST_CHECK(not second.isInterrupted());
+
+    // subsystem restart
+    second.restart();
+    BOOST_CHECK(waitFor([&second_counter]() { return (2 == second_counter); }));
+    BOOST_CHECK_EQUAL(root_counter, static_cast<std::size_t>(1));
+
+    // stopping the root stops children
+    BOOST_CHECK(root.stop());
+    BOOST_CHECK(second.isInterrupted());
+    BOOST_CHECK_EQUAL(first_counter, static_cast<std::size_t>(1));
+}
+
+
+namespace
+{
+    void stopAndMark(const tut::thread::Supervisor<> *supervisor, std::atomic<bool> *stopped)
+    {
+        while (supervisor->sleepFor(std::chrono::seconds(1)))
+        {
+            // idle
+        }
+        *stopped = true;
+    }
+
+
+    void stopAfter(
+            const tut::thread::Supervisor<> *supervisor,
+            const std::atomic<bool> *producer_stopped,
+            std::atomic<bool> *result)
+    {
+        while (supervisor->sleepFor(std::chrono::seconds(1)))
+        {
+            // idle
+        }
+        *result = producer_stopped->load();
+    }
+
+
+    void stopSlowly(const tut::thread::Supervisor<> *supervisor)
+    {
+        while (supervisor->sleepFor(std::chrono::seconds(1)))
+        {
+            // idle
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorShutdown)
+{
+    tut::thread::Supervisor<> supervisor;
+    std::atomic<bool> producer_stopped(false);
+    std::atomic<bool> consumer_result(false);
+
+    // addition order is the opposite of shutdown order
+    supervisor.add(
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Shutdown(/*phase=*/2, /*timeout_ms=*/20),
+                    tut::thread::Parameters::Restart(/*attempts=*/1)),
+            &stopSlowly,
+            &supervisor);
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Shutdown(/*phase=*/1)),
+            &stopAfter,
+            &supervisor,
+            &producer_stopped,
+            &consumer_result);
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Shutdown(/*phase=*/0)),
+            &stopAndMark,
+            &supervisor,
+            &producer_stopped);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const tut::thread::ShutdownReport report = supervisor.shutdown(/*wait_ms=*/1000);
+    BOOST_CHECK_LT(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+            1000);
+
+    BOOST_CHECK(consumer_result);
+    BOOST_CHECK(report.complete_);
+    BOOST_CHECK(not report.isOk());
+    BOOST_REQUIRE_EQUAL(report.missed_deadlines_.size(), static_cast<std::size_t>(1));
+    BOOST_CHECK_EQUAL(report.missed_deadlines_[0].phase_, static_cast<std::size_t>(2));
+    BOOST_CHECK_EQUAL(report.missed_deadlines_[0].timeout_ms_, static_cast<std::size_t>(20));
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorShutdownChild)
+{
+    tut::thread::Supervisor<> root;
+    tut::thread::Supervisor<> child(tut::thread::Supervisor<>::Strategy::ONE_FOR_ONE, &root);
+    std::atomic<bool> producer_stopped(false);
+    std::atomic<bool> consumer_result(false);
+
+    // phases of children are applied when the root is shut down
+    child.add(
+            tut::thread::Parameters(tut::thread::Parameters::Shutdown(/*phase=*/1)),
+            &stopAfter,
+            &child,
+            &producer_stopped,
+            &consumer_result);
+    child.add(
+            tut::thread::Parameters(tut::thread::Parameters::Shutdown(/*phase=*/0)),
+            &stopAndMark,
+            &child,
+            &producer_stopped);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    const tut::thread::ShutdownReport report = root.shutdown(/*wait_ms=*/1000);
+    BOOST_CHECK(report.isOk());
+    BOOST_CHECK(consumer_result);
+    BOOST_CHECK(child.isInterrupted());
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorShutdownDeadline)
+{
+    tut::thread::Supervisor<> supervisor;
+
+    // threads ignore stop requests, every phase misses its deadline
+    for (std::size_t phase = 0; phase < 2; ++phase)
+    {
+        supervisor.add(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Shutdown(phase), tut::thread::Parameters::Restart(/*attempts=*/1)),
+                []() { std::this_thread::sleep_for(std::chrono::milliseconds(1000)); });
+    }
+
+    // phases and the final wait share the time limit
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const tut::thread::ShutdownReport report = supervisor.shutdown(/*wait_ms=*/200);
+    BOOST_CHECK_LT(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+            500);
+    BOOST_CHECK(not report.complete_);
+    BOOST_CHECK_EQUAL(report.missed_deadlines_.size(), static_cast<std::size_t>(2));
+
+    BOOST_CHECK(supervisor.stop());
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorAddAfterStop)
+{
+    TestThreadSupervisor pool;
+    BOOST_CHECK(pool.getThreadSupervisor().stop());
+
+    // rejected without termination of the process
+    BOOST_CHECK(not pool.addSupervisedThread(tut::thread::Parameters(), &TestThreadSupervisor::threadCounter, &pool));
+    const tut::thread::Thread::Reference reference =
+            pool.getThreadSupervisor().spawn(tut::thread::Parameters(), &TestThreadSupervisor::threadCounter, &pool);
+    BOOST_CHECK(not reference.isValid());
+    BOOST_CHECK_EQUAL(pool.counter_, static_cast<std::size_t>(0));
+}
+
+
+namespace
+{
+    void pollStopToken(const tut::thread::Supervisor<> *supervisor, std::atomic<std::size_t> *counter)
+    {
+        const tut::thread::StopToken token = supervisor->getStopToken();
+        while (not token.isStopRequested())
+        {
+            std::this_thread::yield();
+        }
+        ++(*counter);
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorStopToken)
+{
+    tut::thread::Supervisor<> supervisor;
+    std::atomic<std::size_t> counter(0);
+
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+            &pollStopToken,
+            &supervisor,
+            &counter);
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+            &pollStopToken,
+            &supervisor,
+            &counter);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(0));
+
+    supervisor.interrupt();
+    BOOST_CHECK(supervisor.stop());
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(2));
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorTrace)
+{
+    const std::string filename = "thread_supervisor_trace.json";
+    {
+        tut::thread::Supervisor<tut::trace::Chrome<>> supervisor;
+        supervisor.add(
+                tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/2, /*sleep_ms=*/1)),
+                &throwException);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        BOOST_CHECK(supervisor.stop());
+        BOOST_CHECK(supervisor.dump(filename));
+    }
+
+    std::ifstream in(filename);
+    const std::string trace((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    for (const char *name : { "start", "attempt", "exception", "backoff", "drop", "join" })
+    {
+        BOOST_CHECK_MESSAGE(
+                std::string::npos != trace.find(std::string("\"name\": \"") + name + "\""),
+                "missing event " << name);
+    }
+    BOOST_CHECK_EQUAL(trace.rfind("{\"traceEvents\": [", 0), static_cast<std::size_t>(0));
+    std::remove(filename.c_str());
+
+    {
+        // buffers of exited threads are reused
+        tut::thread::Supervisor<tut::trace::Chrome<>> supervisor;
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            const tut::thread::Thread::Reference reference = supervisor.spawn(
+                    tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)), []() {});
+            BOOST_CHECK(waitFor([&supervisor, &reference]() { return (not supervisor.isRunning(reference)); }));
+        }
+        // the calling thread and the sequentially started threads
+        BOOST_CHECK_LE(supervisor.getRingsNumber(), static_cast<std::size_t>(2));
+        BOOST_CHECK(supervisor.stop());
+    }
+}
+
+
+namespace
+{
+    void recordName(std::mutex *mutex, std::vector<std::string> *names)
+    {
+        std::array<char, 16> name{};
+        pthread_getname_np(pthread_self(), name.data(), name.size());
+
+        const std::lock_guard<std::mutex> lock(*mutex);
+        names->emplace_back(name.data());
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorName)
+{
+    BOOST_CHECK_EQUAL(tut::thread::Parameters::Name("decoder", 3).format(2), "decoder.3+2");
+    BOOST_CHECK_EQUAL(tut::thread::Parameters::Name("averyverylongname", 12).format(1), "averyveryl.12+1");
+    BOOST_CHECK_EQUAL(tut::thread::Parameters::Name("averyverylongname").format(0), "averyverylongna");
+
+    std::mutex mutex;
+    std::vector<std::string> names;
+    {
+        tut::thread::Supervisor<> supervisor;
+        supervisor.add(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Name("recorder"), tut::thread::Parameters::Restart(/*attempts=*/3)),
+                &recordName,
+                &mutex,
+                &names);
+        BOOST_CHECK(waitFor(
+                [&mutex, &names]()
+                {
+                    const std::lock_guard<std::mutex> lock(mutex);
+                    return (names.size() >= 3);
+                }));
+        BOOST_CHECK(supervisor.stop());
+    }
+    BOOST_CHECK((std::vector<std::string>{ "recorder", "recorder+1", "recorder+2" }) == names);
+
+    {
+        TestThreadSupervisor supervisor;
+        supervisor.getThreadSupervisor().add(
+                tut::thread::Parameters(tut::thread::Parameters::Name("idle", 1)),
+                &TestThreadSupervisor::threadSleepFor,
+                &supervisor);
+        BOOST_CHECK(
+                waitFor([&supervisor]() { return (not supervisor.getThreadSupervisor().getThreadNames().empty()); }));
+
+        const std::map<std::int64_t, std::string> thread_names = supervisor.getThreadSupervisor().getThreadNames();
+        BOOST_REQUIRE_EQUAL(thread_names.size(), static_cast<std::size_t>(1));
+        BOOST_CHECK_EQUAL(thread_names.begin()->second, "idle.1");
+
+        const std::vector<tut::thread::Metrics> metrics = supervisor.getThreadSupervisor().getMetrics();
+        BOOST_REQUIRE_EQUAL(metrics.size(), static_cast<std::size_t>(1));
+        BOOST_CHECK_EQUAL(metrics[0].tid_, thread_names.begin()->first);
+        BOOST_CHECK_EQUAL(metrics[0].name_, "idle.1");
+
+        BOOST_CHECK(supervisor.getThreadSupervisor().stop());
+        BOOST_CHECK(supervisor.getThreadSupervisor().getThreadNames().empty());
+    }
+}
+
+
+namespace
+{
+    void allocateFromArena(
+            const tut::thread::Supervisor<> *supervisor,
+            std::mutex *mutex,
+            std::vector<const void *> *addresses)
+    {
+        std::pmr::vector<std::uint64_t> data(1024, 0, supervisor->getMemoryResource());
+
+        const std::lock_guard<std::mutex> lock(*mutex);
+        addresses->push_back(data.data());
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorArena)
+{
+    std::mutex mutex;
+    std::vector<const void *> addresses;
+
+    tut::thread::Supervisor<> supervisor;
+    BOOST_CHECK(std::pmr::get_default_resource() == supervisor.getMemoryResource());
+
+    supervisor.add(
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Arena(/*size=*/1 << 16, /*prefault=*/true),
+                    tut::thread::Parameters::Restart(/*attempts=*/3)),
+            &allocateFromArena,
+            &supervisor,
+            &mutex,
+            &addresses);
+    BOOST_CHECK(waitFor(
+            [&mutex, &addresses]()
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                return (addresses.size() >= 3);
+            }));
+    BOOST_CHECK(supervisor.stop());
+
+    // the arena is reset between attempts
+    BOOST_REQUIRE_EQUAL(addresses.size(), static_cast<std::size_t>(3));
+    BOOST_CHECK(addresses[0] == addresses[1]);
+    BOOST_CHECK(addresses[0] == addresses[2]);
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorBatch)
+{
+    TestThreadSupervisor supervisor;
+
+    std::vector<tut::thread::Thread::Reference> references;
+    {
+        tut::thread::Supervisor<>::Batch batch(supervisor.getThreadSupervisor());
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            references.push_back(batch.add(
+                    tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+                    &TestThreadSupervisor::threadCounter,
+                    &supervisor));
+        }
+        for (const tut::thread::Thread::Reference &reference : references)
+        {
+            BOOST_CHECK(supervisor.getThreadSupervisor().waitReady(reference));
+        }
+
+        // held at the barrier
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        BOOST_CHECK_EQUAL(supervisor.counter_, static_cast<std::size_t>(0));
+
+        BOOST_CHECK(batch.start());
+    }
+    BOOST_CHECK(waitFor(
+            [&supervisor, &references]()
+            {
+                return (3 == supervisor.counter_ and not supervisor.getThreadSupervisor().isRunning(references[0]));
+            }));
+
+    // terminated
+    BOOST_CHECK(not supervisor.getThreadSupervisor().waitReady(references[0], /*wait_ms=*/0));
+
+    const tut::thread::Thread::Reference reference = supervisor.getThreadSupervisor().spawn(
+            tut::thread::Parameters(), &TestThreadSupervisor::threadSleepFor, &supervisor);
+    BOOST_CHECK(supervisor.getThreadSupervisor().waitReady(reference));
+}
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorBatchStop)
+{
+    TestThreadSupervisor supervisor;
+
+    // stopped before the batch is started: threads leave the barrier without calling their functions
+    tut::thread::Supervisor<>::Batch batch(supervisor.getThreadSupervisor());
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        const tut::thread::Thread::Reference reference = batch.add(
+                tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/1)),
+                &TestThreadSupervisor::threadCounter,
+                &supervisor);
+        BOOST_CHECK(reference.isValid());
+    }
+    BOOST_CHECK(supervisor.getThreadSupervisor().stop(/*wait_ms=*/1000));
+    BOOST_CHECK_EQUAL(supervisor.counter_, static_cast<std::size_t>(0));
+    BOOST_CHECK(batch.start());
+}
+
+
+namespace
+{
+    void spin(const tut::thread::Supervisor<> *supervisor)
+    {
+        while (not supervisor->isInterrupted())
+        {
+            // busy
+        }
+    }
+
+
+    /// Spins until demoted
+    void spinUntilDemoted(const tut::thread::Supervisor<> *supervisor, std::atomic<std::size_t> *counter)
+    {
+        while (not supervisor->isInterrupted())
+        {
+            int policy = 0;
+            sched_param sched_params;
+            if (0 == pthread_getschedparam(pthread_self(), &policy, &sched_params) and SCHED_IDLE == policy)
+            {
+                ++(*counter);
+                break;
+            }
+        }
+        while (supervisor->sleepFor(std::chrono::seconds(1)))
+        {
+            // idle
+        }
+    }
+
+
+    void allocateAndWait(const tut::thread::Supervisor<> *supervisor)
+    {
+        const std::pmr::vector<char> data(1 << 20, 0, supervisor->getMemoryResource());
+        while (supervisor->sleepFor(std::chrono::seconds(1)))
+        {
+            // idle
+        }
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorBudget)
+{
+    tut::thread::Supervisor<> supervisor;
+    std::atomic<std::size_t> counter(0);
+
+    const tut::thread::Thread::Reference spinning = supervisor.spawn(
+            tut::thread::Parameters(tut::thread::Parameters::Budget(
+                    /*cpu_ms=*/5,
+                    /*window_ms=*/20,
+                    /*memory_bytes=*/0,
+                    tut::thread::Parameters::Budget::Action::TERMINATE)),
+            &spin,
+            &supervisor);
+    supervisor.add(
+            tut::thread::Parameters(tut::thread::Parameters::Budget(
+                    /*cpu_ms=*/5,
+                    /*window_ms=*/20,
+                    /*memory_bytes=*/0,
+                    tut::thread::Parameters::Budget::Action::DEMOTE)),
+            &spinUntilDemoted,
+            &supervisor,
+            &counter);
+    const tut::thread::Thread::Reference allocating = supervisor.spawn(
+            tut::thread::Parameters(tut::thread::Parameters::Budget(
+                    /*cpu_ms=*/0,
+                    /*window_ms=*/20,
+                    /*memory_bytes=*/1024,
+                    tut::thread::Parameters::Budget::Action::LOG)),
+            &allocateAndWait,
+            &supervisor);
+
+    // stopped without restart
+    BOOST_CHECK(waitFor([&supervisor, &spinning]() { return (not supervisor.isRunning(spinning)); }));
+    BOOST_CHECK(waitFor([&counter]() { return (counter > 0); }));
+    BOOST_CHECK(not supervisor.isInterrupted());
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(1));
+
+    BOOST_CHECK(supervisor.isRunning(allocating));
+    for (const tut::thread::Metrics &metrics : supervisor.getMetrics())
+    {
+        if (metrics.reference_.index_ == allocating.index_)
+        {
+            BOOST_CHECK_GE(metrics.allocated_bytes_, static_cast<std::size_t>(1 << 20));
+        }
+    }
+
+    BOOST_CHECK(supervisor.stop());
+}
+
+
+namespace
+{
+    void throwInteger()
+    {
+        throw 42;
+    }
+
+
+    /// Throws on the first attempt only
+    void throwOnce(const tut::thread::Supervisor<> *supervisor, std::atomic<std::size_t> *counter)
+    {
+        if (0 == (*counter)++)
+        {
+            throw std::runtime_error("first attempt");
+        }
+        while (supervisor->sleepFor(std::chrono::seconds(1)))
+        {
+            // idle
+        }
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(ThreadSupervisorExceptionHandler)
+{
+    using Action = tut::thread::Parameters::ExceptionHandler::Action;
+
+    // exceptions of any type are intercepted, escalated on the second attempt
+    {
+        tut::thread::Supervisor<> supervisor;
+        std::mutex mutex;
+        std::vector<std::string> types;
+        std::vector<std::size_t> attempts;
+
+        supervisor.add(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Restart(/*attempts=*/5),
+                        tut::thread::Parameters::ExceptionHandler(
+                                [&mutex, &types, &attempts](const tut::thread::CrashReport &report)
+                                {
+                                    const std::lock_guard<std::mutex> lock(mutex);
+                                    types.push_back(report.getTypeName());
+                                    attempts.push_back(report.attempt_);
+                                    return (report.attempt_ > 0 ? Action::ESCALATE : Action::RESTART);
+                                })),
+                &throwInteger);
+        BOOST_CHECK(waitFor(
+                [&mutex, &types]()
+                {
+                    const std::lock_guard<std::mutex> lock(mutex);
+                    return (types.size() >= 2);
+                }));
+
+        BOOST_CHECK(not supervisor.isInterrupted());
+        BOOST_CHECK(supervisor.stop());
+        BOOST_CHECK((std::vector<std::string>{ "int", "int" }) == types);
+        BOOST_CHECK((std::vector<std::size_t>{ 0, 1 }) == attempts);
+    }
+
+    // killall
+    {
+        tut::thread::Supervisor<> supervisor;
+        supervisor.add(
+                tut::thread::Parameters(
+                        tut::thread::Parameters::Restart(/*attempts=*/5),
+                        tut::thread::Parameters::ExceptionHandler([](const tut::thread::CrashReport & /*report*/)
+                                                                  { return (Action::KILLALL); })),
+                &throwInteger);
+
+        BOOST_CHECK(waitFor([&supervisor]() { return (supervisor.isInterrupted()); }));
+        BOOST_CHECK(supervisor.stop());
+    }
+
+    // crash report of a running thread
+    {
+        tut::thread::Supervisor<> supervisor;
+        std::atomic<std::size_t> counter(0);
+
+        supervisor.add(tut::thread::Parameters(), &throwOnce, &supervisor, &counter);
+        BOOST_CHECK(waitFor([&counter]() { return (2 == counter); }));
+
+        const std::vector<tut::thread::CrashReport> reports = supervisor.getCrashReports();
+        BOOST_REQUIRE_EQUAL(reports.size(), static_cast<std::size_t>(1));
+        BOOST_CHECK_EQUAL(reports[0].getTypeName(), "std::runtime_error");
+        BOOST_CHECK_EQUAL(reports[0].getMessage(), "first attempt");
+        BOOST_CHECK_EQUAL(reports[0].attempt_, static_cast<std::size_t>(0));
+        BOOST_CHECK_THROW(std::rethrow_exception(reports[0].exception_), std::runtime_error);
+
+        BOOST_CHECK(supervisor.stop());
+        BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(2));
+    }
+}
@@ -0,0 +1,173 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief
+*/
+
+
+#define BOOST_TEST_MODULE task_pool
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/results_reporter.hpp>
+
+
+struct GlobalFixtureConfig
+{
+    GlobalFixtureConfig()
+    {
+        boost::unit_test::results_reporter::set_level(boost::unit_test::DETAILED_REPORT);
+    }
+    ~GlobalFixtureConfig() = default;
+};
+
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+// Depending on Boost version a compiler may issue a warning about extra ';',
+// at the same time, compilation may fail on some systems if ';' is omitted.
+BOOST_GLOBAL_FIXTURE(GlobalFixtureConfig);
+#pragma GCC diagnostic pop
+
+
+
+#include "thread_supervisor/task_pool.h"
+
+
+namespace
+{
+    tut::thread::TaskStep sleepAndCount(std::atomic<std::size_t> *counter)
+    {
+        ++(*counter);
+        return (tut::thread::TaskStep::sleepFor(std::chrono::milliseconds(1)));
+    }
+
+
+    tut::thread::TaskStep countAndThrow(std::atomic<std::size_t> *counter)
+    {
+        ++(*counter);
+        throw std::runtime_error("task failure");
+    }
+
+
+    tut::thread::TaskStep yieldUntilInterrupted(
+            tut::thread::Supervisor<> *supervisor,
+            std::atomic<std::size_t> *counter)
+    {
+        ++(*counter);
+        return (supervisor->isInterrupted() ? tut::thread::TaskStep::done() : tut::thread::TaskStep::yield());
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(TaskPoolSleep)
+{
+    const std::size_t tasks_number = 1000;
+    std::atomic<std::size_t> counter(0);
+
+    tut::thread::TaskPool<> pool(/*carriers_number=*/2);
+    for (std::size_t i = 0; i < tasks_number; ++i)
+    {
+        BOOST_CHECK(pool.add(tut::thread::Parameters(), &sleepAndCount, &counter));
+    }
+    BOOST_CHECK_EQUAL(pool.size(), tasks_number);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK_GT(counter, 2 * tasks_number);
+
+    BOOST_CHECK(pool.stop());
+    BOOST_CHECK(not pool.add(tut::thread::Parameters(), &sleepAndCount, &counter));
+
+    // cancelled
+    const std::size_t stopped_counter = counter;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_CHECK_EQUAL(counter, stopped_counter);
+}
+
+
+BOOST_AUTO_TEST_CASE(TaskPoolRestart)
+{
+    std::atomic<std::size_t> counter(0);
+
+    tut::thread::TaskPool<> pool(/*carriers_number=*/1);
+    BOOST_CHECK(pool.add(
+            tut::thread::Parameters(tut::thread::Parameters::Restart(/*attempts=*/3, /*sleep_ms=*/1)),
+            &countAndThrow,
+            &counter));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(3));
+    BOOST_CHECK_EQUAL(pool.size(), static_cast<std::size_t>(0));
+    BOOST_CHECK(not pool.getSupervisor().isInterrupted());
+
+    BOOST_CHECK(pool.stop());
+}
+
+
+BOOST_AUTO_TEST_CASE(TaskPoolKillAll)
+{
+    std::atomic<std::size_t> counter(0);
+    std::atomic<std::size_t> yield_counter(0);
+
+    tut::thread::TaskPool<> pool(/*carriers_number=*/1);
+    BOOST_CHECK(pool.add(
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Restart(/*attempts=*/1),
+                    tut::thread::Parameters::TerminationPolicy::IGNORE),
+            &yieldUntilInterrupted,
+            &pool.getSupervisor(),
+            &yield_counter));
+    BOOST_CHECK(pool.add(
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Restart(/*attempts=*/1),
+                    tut::thread::Parameters::TerminationPolicy::KILLALL),
+            &countAndThrow,
+            &counter));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(1));
+    BOOST_CHECK_GT(yield_counter, static_cast<std::size_t>(0));
+    BOOST_CHECK(pool.getSupervisor().isInterrupted());
+
+    BOOST_CHECK(pool.stop());
+}
+
+
+BOOST_AUTO_TEST_CASE(TaskPoolPass)
+{
+    std::atomic<std::size_t> counter(0);
+    std::atomic<std::size_t> sleep_counter(0);
+
+    // carriers are restarted after passed exceptions
+    tut::thread::TaskPool<> pool(
+            /*carriers_number=*/1,
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Restart(/*attempts=*/0, /*sleep_ms=*/1),
+                    tut::thread::Parameters::ExceptionPolicy::CATCH));
+    BOOST_CHECK(pool.add(tut::thread::Parameters(), &sleepAndCount, &sleep_counter));
+    BOOST_CHECK(pool.add(
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Restart(/*attempts=*/3),
+                    tut::thread::Parameters::ExceptionPolicy::PASS,
+                    tut::thread::Parameters::TerminationPolicy::IGNORE),
+            &countAndThrow,
+            &counter));
+
+    // the failed task is dropped, the other task is not affected
+    for (std::size_t i = 0; i < 1000 and pool.size() > 1; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    BOOST_CHECK_EQUAL(pool.size(), static_cast<std::size_t>(1));
+    BOOST_CHECK_EQUAL(counter, static_cast<std::size_t>(1));
+
+    const std::size_t sleep_counter_before = sleep_counter;
+    for (std::size_t i = 0; i < 1000 and sleep_counter == sleep_counter_before; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    BOOST_CHECK_GT(sleep_counter, sleep_counter_before);
+
+    BOOST_CHECK(pool.stop());
+}
@@ -0,0 +1,194 @@
+/**
+    @file
+    @author  Alexander Sherikov
+    @copyright 2022 Alexander Sherikov. Licensed under the Apache License,
+    Version 2.0. (see LICENSE or http://www.apache.org/licenses/LICENSE-2.0)
+    @brief
+*/
+
+
+#define BOOST_TEST_MODULE worker_group
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <boost/test/results_reporter.hpp>
+
+#include <array>
+
+
+struct GlobalFixtureConfig
+{
+    GlobalFixtureConfig()
+    {
+        boost::unit_test::results_reporter::set_level(boost::unit_test::DETAILED_REPORT);
+    }
+    ~GlobalFixtureConfig() = default;
+};
+
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+// Depending on Boost version a compiler may issue a warning about extra ';',
+// at the same time, compilation may fail on some systems if ';' is omitted.
+BOOST_GLOBAL_FIXTURE(GlobalFixtureConfig);
+#pragma GCC diagnostic pop
+
+
+#include "thread_supervisor/executor.h"
+#include "thread_supervisor/worker_group.h"
+
+
+namespace
+{
+    void replica(const tut::thread::Supervisor<> *supervisor, std::atomic<std::size_t> *running)
+    {
+        ++(*running);
+        while (supervisor->sleepFor(std::chrono::seconds(1)))
+        {
+            // idle
+        }
+        --(*running);
+    }
+
+
+    /// Replica with the given name exits once
+    void replicaExitOnce(
+            const tut::thread::Supervisor<> *supervisor,
+            std::atomic<std::size_t> *running,
+            const char *name,
+            std::atomic<bool> *exit)
+    {
+        std::array<char, 16> thread_name{};
+        pthread_getname_np(pthread_self(), thread_name.data(), thread_name.size());
+
+        ++(*running);
+        bool expected = true;
+        while (supervisor->sleepFor(std::chrono::milliseconds(5)))
+        {
+            if (std::string(name) == thread_name.data() and exit->compare_exchange_strong(expected, false))
+            {
+                break;
+            }
+        }
+        --(*running);
+    }
+
+
+    template <class t_Predicate>
+    bool waitFor(t_Predicate &&predicate, const std::chrono::milliseconds timeout = std::chrono::seconds(10))
+    {
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+        while (not predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return (false);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return (true);
+    }
+
+
+    std::vector<std::string> getSortedNames(tut::thread::Supervisor<> &supervisor)
+    {
+        std::vector<std::string> names;
+        for (const std::pair<const std::int64_t, std::string> &name : supervisor.getThreadNames())
+        {
+            names.push_back(name.second);
+        }
+        std::sort(names.begin(), names.end());
+        return (names);
+    }
+}  // namespace
+
+
+BOOST_AUTO_TEST_CASE(WorkerGroupResize)
+{
+    std::atomic<std::size_t> running(0);
+    tut::thread::WorkerGroup<> group(/*min_size=*/2, /*max_size=*/4);
+
+    BOOST_CHECK(group.start(
+            tut::thread::Parameters(tut::thread::Parameters::Name("replica")),
+            &replica,
+            &group.getSupervisor(),
+            &running));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(group.size(), static_cast<std::size_t>(2));
+    BOOST_CHECK_EQUAL(running, static_cast<std::size_t>(2));
+
+    BOOST_CHECK((std::vector<std::string>{ "replica.0", "replica.1" }) == getSortedNames(group.getSupervisor()));
+
+    // clamped to max
+    BOOST_CHECK(group.resize(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(group.size(), static_cast<std::size_t>(4));
+    BOOST_CHECK_EQUAL(running, static_cast<std::size_t>(4));
+
+    // retired replicas are not restarted, the supervisor is not interrupted
+    BOOST_CHECK(group.resize(3));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(group.size(), static_cast<std::size_t>(3));
+    BOOST_CHECK_EQUAL(running, static_cast<std::size_t>(3));
+    BOOST_CHECK(not group.getSupervisor().isInterrupted());
+
+    BOOST_CHECK(group.stop());
+    BOOST_CHECK_EQUAL(running, static_cast<std::size_t>(0));
+}
+
+
+BOOST_AUTO_TEST_CASE(WorkerGroupReplicaIndex)
+{
+    std::atomic<std::size_t> running(0);
+    std::atomic<bool> exit(false);
+    tut::thread::WorkerGroup<> group(/*min_size=*/3, /*max_size=*/3);
+
+    // nothing to spawn before start
+    BOOST_CHECK(not group.resize(3));
+    BOOST_CHECK_EQUAL(group.size(), static_cast<std::size_t>(0));
+
+    BOOST_CHECK(group.start(
+            tut::thread::Parameters(
+                    tut::thread::Parameters::Name("replica"), tut::thread::Parameters::Restart(/*attempts=*/1)),
+            &replicaExitOnce,
+            &group.getSupervisor(),
+            &running,
+            "replica.0",
+            &exit));
+    BOOST_CHECK(waitFor([&running]() { return (3 == running); }));
+
+    // the first replica terminates on its own, its replacement takes the free index
+    exit = true;
+    BOOST_CHECK(waitFor([&exit]() { return (not exit); }));
+    BOOST_CHECK(waitFor(
+            [&group, &running]()
+            {
+                // the replica is replaced only after it has terminated
+                return (group.resize(3) and 3 == running and 3 == group.getSupervisor().getThreadNames().size());
+            }));
+    BOOST_CHECK(
+            (std::vector<std::string>{ "replica.0", "replica.1", "replica.2" })
+            == getSortedNames(group.getSupervisor()));
+
+    BOOST_CHECK(group.stop());
+}
+
+
+BOOST_AUTO_TEST_CASE(WorkerGroupAutoscale)
+{
+    std::atomic<std::size_t> running(0);
+    std::atomic<std::size_t> load(0);
+    tut::thread::WorkerGroup<> group(/*min_size=*/1, /*max_size=*/8);
+
+    BOOST_CHECK(group.start(tut::thread::Parameters(), &replica, &group.getSupervisor(), &running));
+    BOOST_CHECK(group.autoscale([&load]() { return (load.load()); }, /*load_per_replica=*/10, /*period_ms=*/5));
+
+    load = 25;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_CHECK_EQUAL(running, static_cast<std::size_t>(3));
+
+    load = 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_CHECK_EQUAL(running, static_cast<std::size_t>(1));
+
+    BOOST_CHECK(group.stop());
+}